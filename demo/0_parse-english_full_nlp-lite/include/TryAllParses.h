@@ -26,14 +26,13 @@
 #include <string> // std::string
 #include <sstream> // std::stringstream
 
-bool get_pos_options(std::string               word,
-                     std::vector<std::string>* pos_options);
+const char* const* get_pos_options(const std::string &word);
 void build_all_paths_from_pos_options(std::list<std::vector<int> >*                 all_paths,          // OUT
                                       const std::vector<std::vector<std::string> > &pos_table,          // IN
                                       std::vector<int>*                             path_so_far = NULL, // TEMP
                                       int                                           word_index  = 0);   // TEMP
 void build_pos_paths_from_sentence(std::list<std::vector<std::string> >* all_paths_str, // OUT
-                                   std::string                           sentence,      // IN
+                                   const std::string                    &sentence,      // IN
                                    std::stringstream                     &shared_info_messages);
 
 #endif
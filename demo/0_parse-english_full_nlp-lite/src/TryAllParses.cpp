@@ -32,19 +32,9 @@
 #include "parse-english.h"
 #include "parse-englishLexerIDWrapper.h" // ID_XXX (yacc generated)
 
-bool get_pos_options(std::string              word,
-                    std::vector<std::string>* pos_options)
-{
-    if(word.empty() || !pos_options) {
-        return false;
-    }
-    if(word == "and" || word == "nor" || word == "but" || word == "or" || word == "yet") {
-        pos_options->push_back("CLAUSE(CONJ)");
-        pos_options->push_back("NP(CONJ)");
-        pos_options->push_back("VP(CONJ)");
-    }
-    return pos_options->size();
-}
+#define XLANG_TAG_TABLE_SPEC "PosOptions.def"
+#define XLANG_TAG_TABLE_FUNC get_pos_options
+#include "XLangTagTable.h" // get_pos_options
 
 void build_all_paths_from_pos_options(std::list<std::vector<int> >*                 all_paths,   // OUT
                                       const std::vector<std::vector<std::string> >& pos_table,   // IN
@@ -93,7 +83,7 @@ void build_all_paths_from_pos_options(std::list<std::vector<int> >*
 }
 
 void build_pos_paths_from_sentence(std::list<std::vector<std::string> >*  all_paths_str, // OUT
-                                   std::string                            sentence,      // IN
+                                   const std::string                     &sentence,      // IN
                                    std::stringstream                     &shared_info_messages)
 {
     if(!all_paths_str) {
@@ -112,27 +102,44 @@ void build_pos_paths_from_sentence(std::list<std::vector<std::string> >*  all_pa
     pos_table.resize(words.size());
     int word_index = 0;
     for(std::vector<std::string>::iterator p = words.begin(); p != words.end(); p++) {
-        std::vector<std::string> pos_options;
-        if(get_pos_options(*p, &pos_options)) {
-            for(std::vector<std::string>::iterator q = pos_options.begin(); q != pos_options.end(); q++) {
-                pos_table[word_index].push_back(std::string("{") + *p + "}" + *q);
+        // "word/TAG" or "word/TAG1|TAG2" pins a word to the given tags
+        std::string word = *p;
+        std::vector<std::string> pinned_tags;
+        size_t n = word.find('/');
+        if(n != std::string::npos && n != 0 && n + 1 < word.length()) {
+            pinned_tags = xl::tokenize(word.substr(n + 1), "|");
+            word = word.substr(0, n);
+        }
+        const char* const* pos_options = pinned_tags.size() ? NULL : get_pos_options(word);
+        if(pinned_tags.size()) {
+            for(std::vector<std::string>::iterator q = pinned_tags.begin(); q != pinned_tags.end(); q++) {
+                pos_table[word_index].push_back(std::string("{") + word + "}" + *q);
+            }
+        } else if(pos_options) {
+            for(const char* const* q = pos_options; *q; q++) {
+                pos_table[word_index].push_back(std::string("{") + word + "}" + *q);
             }
         } else {
-            pos_table[word_index].push_back(std::string("{") + *p + "}" + *p);
+            pos_table[word_index].push_back(std::string("{") + word + "}" + word);
         }
 
         // print debug messages
         {
-            shared_info_messages << "INFO: {" << *p << "}:\t";
-            if(pos_options.size()) {
-                for(std::vector<std::string>::iterator r = pos_options.begin(); r != pos_options.end(); r++) {
+            shared_info_messages << "INFO: {" << word << "}:\t";
+            if(pinned_tags.size()) {
+                for(std::vector<std::string>::iterator r = pinned_tags.begin(); r != pinned_tags.end(); r++) {
+                    shared_info_messages << *r << " ";
+                }
+                shared_info_messages << "(pinned)";
+            } else if(pos_options) {
+                for(const char* const* r = pos_options; *r; r++) {
                     shared_info_messages << *r;
-                    if(r != --pos_options.end()) {
+                    if(*(r + 1)) {
                         shared_info_messages << " ";
                     }
                 }
             } else {
-                shared_info_messages << *p;
+                shared_info_messages << word;
             }
             shared_info_messages << std::endl;
         }
@@ -47,6 +47,7 @@
 
 #define MAKE_TERM(lexer_id, ...)   xl::mvc::MVCModel::make_term(&pc->tree_context(), lexer_id, ##__VA_ARGS__)
 #define MAKE_SYMBOL(...)           xl::mvc::MVCModel::make_symbol(&pc->tree_context(), ##__VA_ARGS__)
+#define APPEND_SYMBOL(...)         xl::mvc::MVCModel::append_symbol(&pc->tree_context(), ##__VA_ARGS__)
 #define ERROR_LEXER_ID_NOT_FOUND   "Missing lexer id handler. Did you forgot to register one?"
 #define ERROR_LEXER_NAME_NOT_FOUND "Missing lexer name handler. Did you forgot to register one?"
 
@@ -206,84 +207,84 @@ root:
     ;
 
 S_PUNC:
-      S PUNC { $$ = MAKE_SYMBOL(ID_S_PUNC, 2, $1, $2); }
+      S PUNC { $$ = MAKE_SYMBOL(ID_S_PUNC, $1, $2); }
     ;
 
 S:
-      STMT { $$ = MAKE_SYMBOL(ID_S, 1, $1); }
+      STMT { $$ = MAKE_SYMBOL(ID_S, $1); }
     ;
 
 STMT:
-      CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_STMT, 1, $1); }
+      CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_STMT, $1); }
     ;
 
 CLAUSE:
-      NP_LIST VP_LIST { $$ = MAKE_SYMBOL(ID_CLAUSE, 2, $1, $2); }
+      NP_LIST VP_LIST { $$ = MAKE_SYMBOL(ID_CLAUSE, $1, $2); }
     ;
 
 //=============================================================================
 // NOUN PART -- VERB PART
 
 NP:
-      DET_ADJ_N { $$ = MAKE_SYMBOL(ID_NP, 1, $1); }
-    | ADJ_N     { $$ = MAKE_SYMBOL(ID_NP, 1, $1); }
+      DET_ADJ_N { $$ = MAKE_SYMBOL(ID_NP, $1); }
+    | ADJ_N     { $$ = MAKE_SYMBOL(ID_NP, $1); }
     ;
 
 VP:
-      V_NP { $$ = MAKE_SYMBOL(ID_VP, 1, $1); }
+      V_NP { $$ = MAKE_SYMBOL(ID_VP, $1); }
     ;
 
 //=============================================================================
 // VERB
 
 V_NP:
-      V         { $$ = MAKE_SYMBOL(ID_V_NP, 1, $1); }
-    | V NP_LIST { $$ = MAKE_SYMBOL(ID_V_NP, 2, $1, $2); }
+      V         { $$ = MAKE_SYMBOL(ID_V_NP, $1); }
+    | V NP_LIST { $$ = MAKE_SYMBOL(ID_V_NP, $1, $2); }
     ;
 
 //=============================================================================
 // ADJECTIVE
 
 ADJ_N:
-               N { $$ = MAKE_SYMBOL(ID_ADJ_N, 1, $1); }
-    | ADJ_LIST N { $$ = MAKE_SYMBOL(ID_ADJ_N, 2, $1, $2); }
+               N { $$ = MAKE_SYMBOL(ID_ADJ_N, $1); }
+    | ADJ_LIST N { $$ = MAKE_SYMBOL(ID_ADJ_N, $1, $2); }
     ;
 
 //=============================================================================
 // DEMONSTRATIVE -- ARTICLE/PREFIX-POSSESSIVE
 
 DET_ADJ_N:
-      DEM                     { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, 1, $1); }
-    | DEM               ADJ_N { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, 2, $1, $2); }
-    | ART_OR_PREFIXPOSS ADJ_N { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, 2, $1, $2); }
+      DEM                     { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, $1); }
+    | DEM               ADJ_N { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, $1, $2); }
+    | ART_OR_PREFIXPOSS ADJ_N { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, $1, $2); }
     ;
 
 //=============================================================================
 // LIST
 
 S_LIST:
-             S_PUNC { $$ = MAKE_SYMBOL(ID_S_LIST, 1, $1); }
-    | S_LIST S_PUNC { $$ = MAKE_SYMBOL(ID_S_LIST, 2, $1, $2); }
+             S_PUNC { $$ = MAKE_SYMBOL(ID_S_LIST, $1); }
+    | S_LIST S_PUNC { $$ = APPEND_SYMBOL(ID_S_LIST, $1, $2); }
     ;
 
 CLAUSE_LIST:
-                              CLAUSE { $$ = MAKE_SYMBOL(ID_CLAUSE_LIST, 1, $1); }
-    | CLAUSE_LIST CONJ_CLAUSE CLAUSE { $$ = MAKE_SYMBOL(ID_CLAUSE_LIST, 3, $1, $2, $3); }
+                              CLAUSE { $$ = MAKE_SYMBOL(ID_CLAUSE_LIST, $1); }
+    | CLAUSE_LIST CONJ_CLAUSE CLAUSE { $$ = APPEND_SYMBOL(ID_CLAUSE_LIST, $1, $2, $3); }
     ;
 
 NP_LIST:
-                      NP { $$ = MAKE_SYMBOL(ID_NP_LIST, 1, $1); }
-    | NP_LIST CONJ_NP NP { $$ = MAKE_SYMBOL(ID_NP_LIST, 3, $1, $2, $3); }
+                      NP { $$ = MAKE_SYMBOL(ID_NP_LIST, $1); }
+    | NP_LIST CONJ_NP NP { $$ = APPEND_SYMBOL(ID_NP_LIST, $1, $2, $3); }
     ;
 
 VP_LIST:
-                      VP { $$ = MAKE_SYMBOL(ID_VP_LIST, 1, $1); }
-    | VP_LIST CONJ_VP VP { $$ = MAKE_SYMBOL(ID_VP_LIST, 3, $1, $2, $3); }
+                      VP { $$ = MAKE_SYMBOL(ID_VP_LIST, $1); }
+    | VP_LIST CONJ_VP VP { $$ = APPEND_SYMBOL(ID_VP_LIST, $1, $2, $3); }
     ;
 
 ADJ_LIST:
-               ADJ { $$ = MAKE_SYMBOL(ID_ADJ_LIST, 1, $1); }
-    | ADJ_LIST ADJ { $$ = MAKE_SYMBOL(ID_ADJ_LIST, 2, $1, $2); }
+               ADJ { $$ = MAKE_SYMBOL(ID_ADJ_LIST, $1); }
+    | ADJ_LIST ADJ { $$ = APPEND_SYMBOL(ID_ADJ_LIST, $1, $2); }
     ;
 
 //=========
@@ -524,7 +525,7 @@ bool filter_node(const xl::node::NodeIdentIFace* node)
         return true;
     }
     if(node->type() == xl::node::NodeIdentIFace::IDENT) {
-        std::cout << *dynamic_cast<const xl::node::TermNodeIFace<xl::node::NodeIdentIFace::IDENT>*>(node)->value() << std::endl;
+        std::cout << *xl::node::term_cast<xl::node::NodeIdentIFace::IDENT>(node)->value() << std::endl;
     }
     return true;
 }
@@ -582,7 +583,7 @@ bool export_ast(options_t            &options,
     info_messages << "INFO: Exporting path #" << pos_path_ast_tuple.m_path_index << ": " << pos_path_str << std::endl;
     switch(options.mode) {
         case options_t::MODE_LISP:  output << xl::mvc::MVCView::print_lisp(ast, options.indent); break;
-        case options_t::MODE_GRAPH: output << xl::mvc::MVCView::print_graph(ast); break;
+        case options_t::MODE_GRAPH: output << xl::mvc::MVCView::print_graph(ast, pos_path_ast_tuple.m_path_index); break;
         case options_t::MODE_DOT:   output << xl::mvc::MVCView::print_dot(ast, false, false); break;
         default:
             break;
@@ -1,7 +1,7 @@
 #ifndef ONTOLOGY_H_
 #define ONTOLOGY_H_
 
-#include "visitor/XLangVisitor.h" // visitor::Visitor
+#include "visitor/XLangStaticVisitor.h" // visitor::StaticVisitor
 #include "node/XLangNodeIFace.h" // node::NodeIdentIFace
 #include "parse-englishLexerIDWrapper.h" // ID_XXX (yacc generated)
 #include <algorithm>
@@ -26,18 +26,15 @@ bool is_verb_phrase(const xl::node::NodeIdentIFace* _node);
 bool is_prep(const xl::node::NodeIdentIFace* _node);
 bool is_prep_phrase(const xl::node::NodeIdentIFace* _node);
 
-class NodeGatherer : public xl::visitor::VisitorDFS
+class NodeGatherer : public xl::visitor::StaticVisitor<NodeGatherer>
 {
 public:
     NodeGatherer()
     {}
+    using xl::visitor::StaticVisitor<NodeGatherer>::visit;
     void visit(const xl::node::SymbolNodeIFace*                                _node);
     void visit(const xl::node::TermNodeIFace<xl::node::NodeIdentIFace::IDENT>* _node);
     void visit_null();
-    bool is_printer() const
-    {
-        return false;
-    }
     const node_vector_t& get_not_nodes() const
     {
         return m_not_nodes;
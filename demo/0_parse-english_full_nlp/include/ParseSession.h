@@ -0,0 +1,88 @@
+// parse-english
+// -- A minimum viable English parser implemented in LexYacc
+// Copyright (C) 2011 onlyuser <mailto:onlyuser@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef PARSE_SESSION_H_
+#define PARSE_SESSION_H_
+
+#include "node/XLangNodeIFace.h" // node::NodeIdentIFace
+#include "XLangAlloc.h" // Allocator
+#include "XLangType.h" // uint32_t
+#include <vector> // std::vector
+#include <string> // std::string
+#include <sstream> // std::stringstream
+
+struct session_parse_t
+{
+    std::vector<std::string>  m_pos_path;
+    xl::node::NodeIdentIFace* m_ast;
+};
+
+// Parses a stream one word at a time. Every tag of every word the parser
+// hasn't rejected stays live, and tag paths that leave the parser in the same
+// LR state stack share one alternative, so a new word costs one step per
+// distinct live state rather than per path or a re-parse. Terminating
+// punctuation completes the sentence: the paths to every accepted
+// alternative are built into ASTs (in alloc, as FlatTrees if flat) and the
+// session starts over.
+class ParseSession
+{
+public:
+    ParseSession(xl::Allocator &alloc, bool flat = false)
+        : m_alloc(alloc), m_flat(flat)
+    {
+        reset();
+    }
+
+    // true once word completes a sentence, with its parses (if any) in parses
+    bool push_word(const std::string            &word,
+                   std::vector<session_parse_t>* parses,
+                   std::stringstream            &error_messages);
+    void reset();
+    size_t live_count() const
+    {
+        return m_history.back().size();
+    }
+    size_t word_count() const
+    {
+        return m_history.size() - 1;
+    }
+
+private:
+    // one way into an alternative: a tag of the word, from an alternative of the previous word
+    struct back_pointer_t
+    {
+        int         m_parent;    // in the previous word's alternatives
+        int         m_pos_index; // in the word's tags, to keep paths in tag order
+        std::string m_pos;
+        uint32_t    m_lexer_id;
+    };
+    struct alternative_t
+    {
+        std::vector<back_pointer_t> m_back_pointers;
+        std::vector<int>            m_state_stack;
+    };
+    typedef std::vector<const back_pointer_t*> path_t; // per word
+
+    xl::Allocator                            &m_alloc;
+    bool                                      m_flat;
+    std::vector<std::vector<alternative_t> >  m_history; // per word, the alternatives still live there
+
+    void build_paths(size_t word_index, int alternative_index, path_t* path, std::vector<path_t>* paths) const;
+    static bool path_before(const path_t &x, const path_t &y);
+};
+
+#endif
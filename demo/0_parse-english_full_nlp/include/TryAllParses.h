@@ -20,20 +20,85 @@
 
 #include "node/XLangNodeIFace.h" // node::NodeIdentIFace
 #include "XLangAlloc.h" // Allocator
+#include "XLangType.h" // uint64_t
 #include <vector> // std::vector
 #include <list> // std::list
 #include <stack> // std::stack
 #include <string> // std::string
 #include <sstream> // std::stringstream
+#include <map> // std::map
 
-bool get_pos_options(std::string               word,
-                     std::vector<std::string>* pos_options);
-void build_all_paths_from_pos_options(std::list<std::vector<int> >*                 all_paths,          // OUT
-                                      const std::vector<std::vector<std::string> > &pos_table,          // IN
-                                      std::vector<int>*                             path_so_far = NULL, // TEMP
-                                      int                                           word_index  = 0);   // TEMP
-void build_pos_paths_from_sentence(std::list<std::vector<std::string> >* all_paths_str, // OUT
-                                   std::string                           sentence,      // IN
-                                   std::stringstream                     &shared_info_messages);
+struct pos_stats_t
+{
+    uint32_t m_hit_count; // paths with this (word, tag) choice that parsed
+    uint32_t m_try_count; // paths with this (word, tag) choice that were tried
+
+    pos_stats_t()
+        : m_hit_count(0),
+          m_try_count(0) {}
+};
+
+// keyed by POS-path element "{word}TAG"
+typedef std::map<std::string, pos_stats_t> pos_stats_table_t;
+
+const char* const* get_pos_options(const std::string &word);
+void build_all_paths_from_pos_options(std::list<std::vector<int> >*                 all_paths,             // OUT
+                                      const std::vector<std::vector<std::string> > &pos_table,             // IN
+                                      size_t                                        max_path_count = 0,    // IN (0 for no limit)
+                                      std::vector<int>*                             path_so_far    = NULL, // TEMP
+                                      int                                           word_index     = 0);   // TEMP
+void apply_pos_rules(std::vector<std::vector<std::string> >* pos_table,            // IN/OUT
+                     std::stringstream                      &shared_info_messages);
+bool build_pos_options_from_word(std::vector<std::string>* pos_options, // OUT
+                                 std::string*              word,        // OUT
+                                 const std::string        &token);      // IN ("word" or "word/TAG1|TAG2")
+uint64_t count_pos_paths(const std::vector<std::vector<std::string> > &pos_table); // saturates at UINT64_MAX
+void build_pos_table_from_sentence(std::vector<std::vector<std::string> >* pos_table,            // OUT
+                                   const std::string                      &sentence,             // IN
+                                   std::stringstream                      &shared_info_messages,
+                                   bool                                    use_pos_rules = false);
+void build_pos_paths_from_pos_table(std::list<std::vector<std::string> >*         all_paths_str,        // OUT
+                                    const std::vector<std::vector<std::string> > &pos_table,            // IN
+                                    std::stringstream                            &shared_info_messages,
+                                    size_t                                        max_path_count = 0);  // IN (0 for no limit)
+bool decode_path_index(const std::vector<std::vector<std::string> > &pos_table,  // IN
+                       uint64_t                                      path_index, // IN
+                       std::vector<int>*                             path);      // OUT
+void sample_path_indices(std::vector<uint64_t>* path_indices, // OUT
+                         uint64_t               path_count,   // IN
+                         size_t                 sample_count, // IN
+                         uint64_t               seed);        // IN
+void range_path_indices(std::vector<uint64_t>* path_indices,     // OUT
+                        uint64_t               path_count,       // IN
+                        uint64_t               start,            // IN
+                        uint64_t               end,              // IN (exclusive)
+                        size_t                 max_path_count);  // IN (0 for no limit)
+void build_pos_paths_from_path_indices(std::list<std::vector<std::string> >*         all_paths_str,         // OUT
+                                       const std::vector<std::vector<std::string> > &pos_table,             // IN
+                                       const std::vector<uint64_t>                  &path_indices,          // IN
+                                       std::stringstream                            &shared_info_messages);
+bool load_pos_stats(pos_stats_table_t* pos_stats_table, const std::string &filename);
+bool save_pos_stats(const pos_stats_table_t &pos_stats_table, const std::string &filename);
+void read_pos_stats(pos_stats_table_t* pos_stats_table, std::istream &is);        // same format as the stats file
+void write_pos_stats(const pos_stats_table_t &pos_stats_table, std::ostream &os);
+void merge_pos_stats(pos_stats_table_t*       pos_stats_table, // IN/OUT
+                     const pos_stats_table_t &delta);          // IN (counts to add)
+void update_pos_stats(pos_stats_table_t*              pos_stats_table, // IN/OUT
+                      const std::vector<std::string> &pos_path,        // IN
+                      bool                            success);        // IN
+uint64_t encode_path(const std::vector<std::vector<std::string> > &pos_table, // IN
+                     const std::vector<int>                       &path);     // IN
+void build_best_first_path_indices(std::vector<uint64_t>*                        path_indices,        // OUT
+                                   const std::vector<std::vector<std::string> > &pos_table,           // IN
+                                   const pos_stats_table_t                      &pos_stats_table,     // IN
+                                   size_t                                        max_path_count = 0); // IN (0 for no limit)
+void build_beam_path_indices(std::vector<uint64_t>*                        path_indices,    // OUT
+                             const std::vector<std::vector<std::string> > &pos_table,       // IN
+                             const pos_stats_table_t                      &pos_stats_table, // IN
+                             size_t                                        beam_width);     // IN
+void build_pos_paths_from_sentence(std::list<std::vector<std::string> >* all_paths_str,         // OUT
+                                   const std::string                    &sentence,              // IN
+                                   std::stringstream                     &shared_info_messages,
+                                   bool                                  use_pos_rules = false);
 
 #endif
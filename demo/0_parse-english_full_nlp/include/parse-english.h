@@ -21,15 +21,28 @@
 #include "XLangType.h" // uint32_t
 #include "XLangAlloc.h" // Allocator
 #include "node/XLangNodeIFace.h" // node::NodeIdentIFace
+#include "node/XLangNode.h" // node::SymbolNode
+#include "node/XLangFlatTree.h" // node::FlatTree
+#include "mvc/XLangMVCModel.h" // mvc::MVCModel
 #include "XLangTreeContext.h" // TreeContext
 #include <vector> // std::vector
 #include <list> // std::list
 #include <map> // std::map
 #include <string> // std::string
 #include <sstream> // std::stringstream
+#include <atomic> // std::atomic
+
+#define ERROR_DEADLINE_EXCEEDED "Deadline exceeded"
 
 #include "../../0_parse-english_full_nlp/include/parse-englishLexerIDWrapper.h" // YYLTYPE (generated)
 
+// what grammar actions pass around: a node, or a slot when building flat
+struct ast_ref_t
+{
+    xl::node::NodeIdentIFace*   m_node;
+    xl::node::FlatTree::index_t m_index;
+};
+
 // type of yylval to be set by scanner actions
 // implemented as %union in non-reentrant mode
 struct SynthAttrib
@@ -42,6 +55,7 @@ struct SynthAttrib
         xl::node::TermInternalType<xl::node::NodeIdentIFace::CHAR>::type   char_value;   // char value
         xl::node::TermInternalType<xl::node::NodeIdentIFace::IDENT>::type  ident_value;  // symbol table index
         xl::node::TermInternalType<xl::node::NodeIdentIFace::SYMBOL>::type symbol_value; // node pointer
+        ast_ref_t                                                          ast_value;    // node or flat slot
     };
 };
 #define YYSTYPE SynthAttrib
@@ -67,8 +81,82 @@ struct ScannerContext
 
     std::vector<uint32_t>* m_pos_lexer_id_path;
 
+    const std::atomic<bool>* m_cancel; // polled once per token
+
     ScannerContext(const char* buf);
     uint32_t current_lexer_id();
+    void check_cancel() const
+    {
+        if(m_cancel && m_cancel->load(std::memory_order_relaxed)) {
+            throw ERROR_DEADLINE_EXCEEDED;
+        }
+    }
+};
+
+// Builds an AST either out of nodes in the TreeContext (through MVCModel) or,
+// given a FlatTree, straight into its slots, so the grammar actions are the
+// same for both models and no pointer tree is built just to be flattened.
+class TreeBuilder
+{
+public:
+    TreeBuilder(xl::TreeContext* tc, xl::node::FlatTree* flat_tree = NULL)
+        : m_tc(tc), m_flat_tree(flat_tree)
+    {}
+    template<class T>
+    ast_ref_t make_term(uint32_t lexer_id, T value)
+    {
+        if(m_flat_tree) {
+            return ref(m_flat_tree->make_term(lexer_id, value));
+        }
+        return ref(xl::mvc::MVCModel::make_term(m_tc, lexer_id, value));
+    }
+    template<class... T>
+    ast_ref_t make_symbol(uint32_t lexer_id, T... children)
+    {
+        if(m_flat_tree) {
+            return ref(m_flat_tree->make_symbol(lexer_id, children.m_index...));
+        }
+        return ref(xl::mvc::MVCModel::make_symbol(m_tc, lexer_id, children.m_node...));
+    }
+    ast_ref_t make_symbol(uint32_t lexer_id, const std::vector<ast_ref_t> &children);
+    template<class... T>
+    ast_ref_t append_symbol(uint32_t lexer_id, ast_ref_t list, T... children)
+    {
+        if(m_flat_tree) {
+            return ref(m_flat_tree->append_symbol(lexer_id, list.m_index, children.m_index...));
+        }
+        return ref(xl::mvc::MVCModel::append_symbol(m_tc, lexer_id, list.m_node, children.m_node...));
+    }
+    ast_ref_t copy(const xl::node::NodeIdentIFace* _node); // any node, from any tree
+    ast_ref_t null() const
+    {
+        return m_flat_tree ? ref(xl::node::FlatTree::NIL) : ref(static_cast<xl::node::NodeIdentIFace*>(NULL));
+    }
+    ast_ref_t eol() const
+    {
+        return m_flat_tree ? ref(xl::node::FlatTree::EOL) : ref(xl::node::SymbolNode::eol());
+    }
+    void set_root(ast_ref_t root);
+    xl::node::NodeIdentIFace* finish(); // the root, viewed through a FlatTreeView in tree_context() if flat
+    xl::TreeContext &tree_context()
+    {
+        return *m_tc;
+    }
+
+private:
+    xl::TreeContext*    m_tc;
+    xl::node::FlatTree* m_flat_tree;
+
+    static ast_ref_t ref(xl::node::NodeIdentIFace* _node)
+    {
+        ast_ref_t r = {_node, xl::node::FlatTree::NIL};
+        return r;
+    }
+    static ast_ref_t ref(xl::node::FlatTree::index_t index)
+    {
+        ast_ref_t r = {NULL, index};
+        return r;
+    }
 };
 
 // context type to hold shared data between bison and flex
@@ -77,13 +165,17 @@ class ParserContext
 public:
     std::stringstream m_error_messages;
 
-    ParserContext(xl::Allocator &alloc, const char* buf)
-        : m_tree_context(alloc), m_scanner_context(buf)
+    ParserContext(xl::Allocator &alloc, const char* buf, xl::node::FlatTree* flat_tree = NULL)
+        : m_tree_context(alloc), m_tree_builder(&m_tree_context, flat_tree), m_scanner_context(buf)
     {}
     xl::TreeContext &tree_context()
     {
         return m_tree_context;
     }
+    TreeBuilder &tree_builder()
+    {
+        return m_tree_builder;
+    }
     ScannerContext &scanner_context()
     {
         return m_scanner_context;
@@ -91,6 +183,7 @@ public:
 
 private:
     xl::TreeContext m_tree_context;
+    TreeBuilder     m_tree_builder;
     ScannerContext  m_scanner_context;
 };
 #define YY_EXTRA_TYPE ParserContext*
@@ -109,9 +202,12 @@ int yylex(YYSTYPE* yylval_param, YYLTYPE* yylloc_param, yyscan_t yyscanner);
 std::string id_to_name(uint32_t lexer_id);
 uint32_t name_to_id(std::string name);
 uint32_t quick_lex(const char* s);
-
 xl::node::NodeIdentIFace* make_ast(xl::Allocator &alloc, const char* s,
-                                   std::map<std::string, uint32_t>* lexer_id_map,
-                                   std::vector<uint32_t> &pos_lexer_id_path);
+                                   std::vector<uint32_t> &pos_lexer_id_path,
+                                   std::stringstream &error_messages,
+                                   const std::atomic<bool>* cancel = NULL,
+                                   xl::node::FlatTree*      flat_tree = NULL);
+xl::node::FlatTree* new_flat_tree(xl::Allocator &alloc); // in alloc, charged to alloc's budget
+bool lr_advance(std::vector<int>* state_stack, uint32_t lexer_id);
 
 #endif
@@ -126,34 +126,34 @@ bool is_prep_phrase(const xl::node::NodeIdentIFace* _node)
 
 void NodeGatherer::visit(const xl::node::SymbolNodeIFace* _node)
 {
-    if(is_sentence(dynamic_cast<const xl::node::NodeIdentIFace*>(_node))) {
-        m_sentence_nodes.push_back(dynamic_cast<const xl::node::NodeIdentIFace*>(_node));
+    if(is_sentence(_node)) {
+        m_sentence_nodes.push_back(_node);
     }
-    if(is_clause(dynamic_cast<const xl::node::NodeIdentIFace*>(_node))) {
-        m_clause_nodes.push_back(dynamic_cast<const xl::node::NodeIdentIFace*>(_node));
+    if(is_clause(_node)) {
+        m_clause_nodes.push_back(_node);
     }
-    if(is_verb_phrase(dynamic_cast<const xl::node::NodeIdentIFace*>(_node))) {
-        m_verb_phrase_nodes.push_back(dynamic_cast<const xl::node::NodeIdentIFace*>(_node));
+    if(is_verb_phrase(_node)) {
+        m_verb_phrase_nodes.push_back(_node);
     }
-    if(is_prep_phrase(dynamic_cast<const xl::node::NodeIdentIFace*>(_node))) {
-        m_prep_phrase_nodes.push_back(dynamic_cast<const xl::node::NodeIdentIFace*>(_node));
+    if(is_prep_phrase(_node)) {
+        m_prep_phrase_nodes.push_back(_node);
     }
-    xl::visitor::VisitorDFS::visit(_node);
+    StaticVisitor::visit(_node);
 }
 
 void NodeGatherer::visit(const xl::node::TermNodeIFace<xl::node::NodeIdentIFace::IDENT>* _node)
 {
     if(is_not(_node)) {
-        m_not_nodes.push_back(dynamic_cast<const xl::node::NodeIdentIFace*>(_node));
+        m_not_nodes.push_back(_node);
     }
     if(is_noun(_node)) {
-        m_noun_nodes.push_back(dynamic_cast<const xl::node::NodeIdentIFace*>(_node));
+        m_noun_nodes.push_back(_node);
     }
     if(is_verb(_node)) {
-        m_verb_nodes.push_back(dynamic_cast<const xl::node::NodeIdentIFace*>(_node));
+        m_verb_nodes.push_back(_node);
     }
     if(is_prep(_node)) {
-        m_prep_nodes.push_back(dynamic_cast<const xl::node::NodeIdentIFace*>(_node));
+        m_prep_nodes.push_back(_node);
     }
 }
 
@@ -163,7 +163,7 @@ void NodeGatherer::visit_null() {
 std::string Noun::to_string(int indent) const
 {
     std::stringstream ss;
-    std::string name = m_node ? *dynamic_cast<const xl::node::TermNodeIFace<xl::node::NodeIdentIFace::IDENT>*>(m_node)->value() : m_tag;
+    std::string name = m_node ? *xl::node::term_cast<xl::node::NodeIdentIFace::IDENT>(m_node)->value() : m_tag;
     ss << std::string(4 * indent, ' ') << "(NOUN \"" << name << "\")" << std::endl;
     return ss.str();
 }
@@ -171,7 +171,7 @@ std::string Noun::to_string(int indent) const
 std::string Verb::to_string(int indent) const
 {
     std::stringstream ss;
-    std::string name = m_node ? *dynamic_cast<const xl::node::TermNodeIFace<xl::node::NodeIdentIFace::IDENT>*>(m_node)->value() : m_tag;
+    std::string name = m_node ? *xl::node::term_cast<xl::node::NodeIdentIFace::IDENT>(m_node)->value() : m_tag;
     ss << std::string(4 * indent, ' ') << "(VERB \"" << name << "\")" << std::endl;
     return ss.str();
 }
@@ -179,7 +179,7 @@ std::string Verb::to_string(int indent) const
 std::string Prep::to_string(int indent) const
 {
     std::stringstream ss;
-    std::string name = m_node ? *dynamic_cast<const xl::node::TermNodeIFace<xl::node::NodeIdentIFace::IDENT>*>(m_node)->value() : m_tag;
+    std::string name = m_node ? *xl::node::term_cast<xl::node::NodeIdentIFace::IDENT>(m_node)->value() : m_tag;
     ss << std::string(4 * indent, ' ') << "(PREP \"" << name << "\")" << std::endl;
     return ss.str();
 }
@@ -688,7 +688,7 @@ std::vector<Sentence*> extract_ontology(const xl::node::NodeIdentIFace* ast)
                 // if passive voice and prep is "by", swap subject with indirect object
                 for(std::vector<PrepPhrase*>::iterator p = prep_phrases.begin(); p != prep_phrases.end(); p++) {
                     Prep* prep = (*p)->get_prep();
-                    std::string prep_str = *dynamic_cast<const xl::node::TermNodeIFace<xl::node::NodeIdentIFace::IDENT>*>(prep->get_node())->value();
+                    std::string prep_str = *xl::node::term_cast<xl::node::NodeIdentIFace::IDENT>(prep->get_node())->value();
                     if(prep_str == "{by}") {
                         // EXAMPLE
                         // =======
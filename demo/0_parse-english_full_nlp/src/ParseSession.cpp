@@ -0,0 +1,140 @@
+// parse-english
+// -- A minimum viable English parser implemented in LexYacc
+// Copyright (C) 2011 onlyuser <mailto:onlyuser@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "ParseSession.h"
+#include "TryAllParses.h" // build_pos_options_from_word
+#include "parse-english.h" // make_ast, new_flat_tree, lr_advance, name_to_id
+#include <vector> // std::vector
+#include <map> // std::map
+#include <string> // std::string
+#include <sstream> // std::stringstream
+#include <algorithm> // std::sort
+
+void ParseSession::reset()
+{
+    m_history.clear();
+    m_history.resize(1);
+    m_history[0].push_back(alternative_t());
+}
+
+// every tag path from the first word to the given alternative
+void ParseSession::build_paths(size_t word_index, int alternative_index, path_t* path, std::vector<path_t>* paths) const
+{
+    if(!word_index) {
+        paths->push_back(*path);
+        return;
+    }
+    const alternative_t &alternative = m_history[word_index][alternative_index];
+    for(std::vector<back_pointer_t>::const_iterator p = alternative.m_back_pointers.begin();
+            p != alternative.m_back_pointers.end(); p++)
+    {
+        (*path)[word_index - 1] = &(*p);
+        build_paths(word_index - 1, (*p).m_parent, path, paths);
+    }
+}
+
+// the order paths came in before alternatives were shared: by the last word's
+// tag, then the one before it, and so on
+bool ParseSession::path_before(const path_t &x, const path_t &y)
+{
+    for(size_t word_index = x.size(); word_index > 0; word_index--) {
+        if(x[word_index - 1]->m_pos_index != y[word_index - 1]->m_pos_index) {
+            return x[word_index - 1]->m_pos_index < y[word_index - 1]->m_pos_index;
+        }
+    }
+    return false;
+}
+
+bool ParseSession::push_word(const std::string            &word,
+                             std::vector<session_parse_t>* parses,
+                             std::stringstream            &error_messages)
+{
+    std::vector<std::string> pos_options;
+    std::string _word;
+    build_pos_options_from_word(&pos_options, &_word, word);
+
+    // advance each live alternative by each tag, merging the ones that land
+    // on the same state stack
+    std::vector<alternative_t> &alternatives = m_history.back();
+    std::vector<alternative_t> next_alternatives;
+    std::map<std::vector<int>, int> state_stack_to_alternative;
+    for(std::vector<std::string>::iterator p = pos_options.begin(); p != pos_options.end(); p++) {
+        uint32_t lexer_id = 0;
+        try {
+            lexer_id = name_to_id(*p);
+        } catch(const char* s) {
+            continue;
+        }
+        for(size_t i = 0; i < alternatives.size(); i++) {
+            std::vector<int> state_stack = alternatives[i].m_state_stack;
+            if(!lr_advance(&state_stack, lexer_id)) {
+                continue;
+            }
+            std::map<std::vector<int>, int>::iterator q = state_stack_to_alternative.find(state_stack);
+            if(q == state_stack_to_alternative.end()) {
+                q = state_stack_to_alternative.insert(std::make_pair(state_stack, static_cast<int>(next_alternatives.size()))).first;
+                next_alternatives.push_back(alternative_t());
+                next_alternatives.back().m_state_stack.swap(state_stack);
+            }
+            back_pointer_t back_pointer;
+            back_pointer.m_parent    = static_cast<int>(i);
+            back_pointer.m_pos_index = static_cast<int>(p - pos_options.begin());
+            back_pointer.m_pos       = *p;
+            back_pointer.m_lexer_id  = lexer_id;
+            next_alternatives[(*q).second].m_back_pointers.push_back(back_pointer);
+        }
+    }
+    for(std::vector<alternative_t>::iterator r = alternatives.begin(); r != alternatives.end(); r++) {
+        std::vector<int>().swap((*r).m_state_stack); // only the newest stacks are advanced
+    }
+    m_history.push_back(next_alternatives);
+    if(_word != "." && _word != "?" && _word != "!") {
+        return false;
+    }
+
+    // sentence complete, build an AST for every path to an alternative the parser accepts
+    if(parses) {
+        parses->clear();
+    }
+    std::vector<path_t> paths;
+    path_t path(word_count());
+    std::vector<alternative_t> &last_alternatives = m_history.back();
+    for(size_t i = 0; i < last_alternatives.size(); i++) {
+        std::vector<int> state_stack = last_alternatives[i].m_state_stack;
+        if(lr_advance(&state_stack, 0)) {
+            build_paths(word_count(), static_cast<int>(i), &path, &paths);
+        }
+    }
+    std::sort(paths.begin(), paths.end(), path_before);
+    for(std::vector<path_t>::iterator s = paths.begin(); s != paths.end(); s++) {
+        session_parse_t parse;
+        std::vector<uint32_t> pos_lexer_id_path;
+        std::string pos_path_str;
+        for(path_t::iterator t = (*s).begin(); t != (*s).end(); t++) {
+            parse.m_pos_path.push_back((*t)->m_pos);
+            pos_lexer_id_path.push_back((*t)->m_lexer_id);
+            pos_path_str.append((*t)->m_pos + " ");
+        }
+        parse.m_ast = make_ast(m_alloc, pos_path_str.c_str(), pos_lexer_id_path, error_messages, NULL,
+                               m_flat ? new_flat_tree(m_alloc) : NULL);
+        if(parse.m_ast && parses) {
+            parses->push_back(parse);
+        }
+    }
+    reset();
+    return true;
+}
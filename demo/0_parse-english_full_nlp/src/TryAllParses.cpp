@@ -28,136 +28,138 @@
 #include <sstream> // std::stringstream
 #include <algorithm> // std::sort
 #include <iostream> // std::cerr
+#include <limits> // std::numeric_limits
+#include <set> // std::set
+#include <random> // std::mt19937_64
+#include <queue> // std::priority_queue
+#include <fstream> // std::ifstream
+#include <math.h> // log
 
 #include "parse-english.h"
 #include "parse-englishLexerIDWrapper.h" // ID_XXX (yacc generated)
 
-bool get_pos_options(std::string              word,
-                    std::vector<std::string>* pos_options)
+#define XLANG_TAG_TABLE_SPEC "PosOptions.def"
+#define XLANG_TAG_TABLE_FUNC get_pos_options
+#include "XLangTagTable.h" // get_pos_options
+
+struct pos_rule_t
 {
-    if(word.empty() || !pos_options) {
-        return false;
+    const char*     m_name;
+    uint32_t        m_lexer_id;
+    int             m_offset;
+    const uint32_t* m_context_lexer_ids; // 0-terminated
+};
+
+#define POS_RULE(name, lexer_id, offset, ...) static const uint32_t name##_CONTEXT[] = {__VA_ARGS__, 0};
+#include "PosRules.def"
+#undef POS_RULE
+
+static const pos_rule_t pos_rules[] = {
+#define POS_RULE(name, lexer_id, offset, ...) {#name, lexer_id, offset, name##_CONTEXT},
+#include "PosRules.def"
+#undef POS_RULE
+};
+static const size_t pos_rule_count = sizeof(pos_rules) / sizeof(pos_rules[0]);
+
+typedef std::map<uint32_t, std::vector<const pos_rule_t*> > lexer_id_to_rules_t;
+
+static lexer_id_to_rules_t build_lexer_id_to_rules()
+{
+    lexer_id_to_rules_t lexer_id_to_rules;
+    for(size_t i = 0; i < pos_rule_count; i++) {
+        lexer_id_to_rules[pos_rules[i].m_lexer_id].push_back(&pos_rules[i]);
     }
-    if(word == "be") {
-        pos_options->push_back("BE(be)");
-        pos_options->push_back("CMD(be)");
-    } else if(word == "do" || word == "does" || word == "did") {
-        pos_options->push_back("DO(do)");
-        pos_options->push_back("V(do)");
-    } else if(word == "done") {
-        pos_options->push_back("VPASTPERF(do)");
-    } else if(word == "for") {
-        pos_options->push_back("CLAUSE(CONJ)");
-        pos_options->push_back("NP(CONJ)");
-        pos_options->push_back("VP(CONJ)");
-        pos_options->push_back("ADJ(CONJ)");
-        pos_options->push_back("PREP(CONJ)");
-        pos_options->push_back("PREP(x)");
-    } else if(/*word == "for" ||*/ word == "and" || word == "nor" || word == "but" || word == "or" || word == "yet" /*|| word == "so"*/) {
-        pos_options->push_back("CLAUSE(CONJ)");
-        pos_options->push_back("NP(CONJ)");
-        pos_options->push_back("VP(CONJ)");
-        pos_options->push_back("ADJ(CONJ)");
-        pos_options->push_back("PREP(CONJ)");
-    } else if(word == "going") {
-        pos_options->push_back("VGERUND");
-        pos_options->push_back("GOING-INFIN");
-    } else if(word == ",") {
-        pos_options->push_back("CLAUSE(CONJ)");
-        pos_options->push_back("NP(CONJ)");
-        pos_options->push_back("VP(CONJ)");
-        pos_options->push_back("ADJ(CONJ)");
-        pos_options->push_back("PREP(CONJ)");
-        pos_options->push_back("then");
-    } else if(word == "have" || word == "has") {
-        pos_options->push_back("AUX(have)");
-        pos_options->push_back("V");
-        pos_options->push_back("V-INFIN");
-    } else if(word == "had") {
-        pos_options->push_back("AUX(have)");
-        pos_options->push_back("V-INFIN");
-        pos_options->push_back("VPAST");
-        pos_options->push_back("VPASTPERF");
-    } else if(word == "come" || word == "run" || word == "put") {
-        pos_options->push_back("V");
-        pos_options->push_back("VPASTPERF");
-    } else if(word == "read") {
-        pos_options->push_back("V");
-        pos_options->push_back("VPAST");
-        pos_options->push_back("VPASTPERF");
-    } else if(/*word == "like" ||*/ word == "likes" ||
-              word == "need" || word == "needs" ||
-              word == "want" || word == "wants" ||
-              word == "hate" || word == "hates" ||
-              word == "kill" || word == "kills" ||
-              word == "meet" || word == "meets")
-    {
-        pos_options->push_back("V");
-        pos_options->push_back("V-INFIN");
-    } else if(word == "walked" || word == "jumped" || word == "crawled" ||
-              word == "lent"   || word == "bought" || word == "sold"    ||
-              word == "told"   || word == "said"   || word == "heard"   || word == "listened" || word == "looked" ||
-              word == "worked" || word == "slept"  || word == "died"    ||
-              word == "liked"  || word == "needed" || word == "wanted"  || word == "hated" || word == "killed" || word == "met")
-    {
-        pos_options->push_back("VPAST");
-        pos_options->push_back("VPASTPERF");
-    } else if(word == "quickly") {
-        pos_options->push_back("ADV-ADJ");
-        pos_options->push_back("ADV-V");
-        pos_options->push_back("ADV-VGERUND_PRE");
-        pos_options->push_back("ADV-VGERUND_POST");
-    } else if(word == "very") {
-        pos_options->push_back("ADV-ADJ");
-    } else if(word == "so") {
-        pos_options->push_back("CLAUSE(CONJ)");
-        pos_options->push_back("ADV-ADJ");
-    } else if(word == "to") {
-        pos_options->push_back("to-V");
-        pos_options->push_back("PREP(x)");
-    } else if(word == "are_or_were") {
-        pos_options->push_back("are");
-        pos_options->push_back("were");
-    } else if(word == "did_or_had_or_would") {
-        pos_options->push_back("VPAST(do)");
-        pos_options->push_back("AUX(have)");
-        pos_options->push_back("would");
-    } else if(word == "is_or_has_or_poss") {
-        pos_options->push_back("SUFFIX-POSS");
-        pos_options->push_back("is");
-        pos_options->push_back("AUX(have)");
-    } else if(word == "that") {
-        pos_options->push_back("DEM(that)");
-        pos_options->push_back("WH-WORD(that)");
-    } else if(word == "never"     || word == "ever"    || word == "even" ||
-              word == "only"      || word == "just"    ||
-              word == "also"      || word == "as-well" ||
-              word == "neither"   || word == "either"  ||
-              word == "seldom"    || word == "rarely"  ||
-              word == "sometimes" || word == "always"  ||
-              word == "often"     || word == "usually" || word == "frequently")
-    {
-        pos_options->push_back("FREQ");
-        pos_options->push_back("FREQ_EOS");
-    } else if(word == "as") {
-        pos_options->push_back("CMP(as)");
-        pos_options->push_back("PREP(as)");
-    } else if(word == "like") {
-        pos_options->push_back("V");
-        pos_options->push_back("V-INFIN");
-        pos_options->push_back("CMP(like)");
-    }
-    return pos_options->size();
+    return lexer_id_to_rules;
+}
+
+// rules by the lexer id they drop; built during static initialization, so
+// the corpus stage threads only ever read it
+static const lexer_id_to_rules_t lexer_id_to_rules = build_lexer_id_to_rules();
+
+static uint32_t pos_to_lexer_id(const std::string &pos)
+{
+    try {
+        return name_to_id(pos);
+    } catch(const char* s) {
+        return 0; // matches no rule
+    }
+}
+
+static bool all_in_context(const std::vector<uint32_t> &lexer_ids, const uint32_t* context_lexer_ids)
+{
+    for(std::vector<uint32_t>::const_iterator p = lexer_ids.begin(); p != lexer_ids.end(); p++) {
+        const uint32_t* q = context_lexer_ids;
+        while(*q && *q != *p) {
+            q++;
+        }
+        if(!*q) {
+            return false;
+        }
+    }
+    return true;
 }
 
-void build_all_paths_from_pos_options(std::list<std::vector<int> >*                 all_paths,   // OUT
-                                      const std::vector<std::vector<std::string> >& pos_table,   // IN
-                                      std::vector<int>*                             path_so_far, // TEMP
-                                      int                                           word_index)  // TEMP
+void apply_pos_rules(std::vector<std::vector<std::string> >* pos_table,            // IN/OUT
+                     std::stringstream                      &shared_info_messages)
+{
+    if(!pos_table) {
+        return;
+    }
+
+    std::vector<std::vector<uint32_t> > lexer_id_table(pos_table->size());
+    for(size_t i = 0; i < pos_table->size(); i++) {
+        for(std::vector<std::string>::iterator p = (*pos_table)[i].begin(); p != (*pos_table)[i].end(); p++) {
+            lexer_id_table[i].push_back(pos_to_lexer_id(*p));
+        }
+    }
+
+    // one left-to-right pass; later words see the earlier words' drops
+    std::map<const pos_rule_t*, int> hit_counts;
+    for(size_t i = 0; i < lexer_id_table.size(); i++) {
+        std::vector<uint32_t> &lexer_ids = lexer_id_table[i];
+        size_t j = 0;
+        while(j < lexer_ids.size() && lexer_ids.size() > 1) {
+            const pos_rule_t* hit_rule = NULL;
+            lexer_id_to_rules_t::const_iterator p = lexer_id_to_rules.find(lexer_ids[j]);
+            if(p != lexer_id_to_rules.end()) {
+                for(std::vector<const pos_rule_t*>::const_iterator q = (*p).second.begin(); q != (*p).second.end(); q++) {
+                    int k = static_cast<int>(i) + (*q)->m_offset;
+                    if(k >= 0 && k < static_cast<int>(lexer_id_table.size()) &&
+                            all_in_context(lexer_id_table[k], (*q)->m_context_lexer_ids))
+                    {
+                        hit_rule = *q;
+                        break;
+                    }
+                }
+            }
+            if(hit_rule) {
+                lexer_ids.erase(lexer_ids.begin() + j);
+                (*pos_table)[i].erase((*pos_table)[i].begin() + j);
+                hit_counts[hit_rule]++;
+                continue;
+            }
+            j++;
+        }
+    }
+
+    // print debug messages
+    for(size_t i = 0; i < pos_rule_count; i++) {
+        shared_info_messages << "INFO: Rule " << pos_rules[i].m_name << ": " << hit_counts[&pos_rules[i]] << " hit(s)" << std::endl;
+    }
+}
+
+void build_all_paths_from_pos_options(std::list<std::vector<int> >*                 all_paths,      // OUT
+                                      const std::vector<std::vector<std::string> >& pos_table,      // IN
+                                      size_t                                        max_path_count, // IN
+                                      std::vector<int>*                             path_so_far,    // TEMP
+                                      int                                           word_index)     // TEMP
 {
     if(!all_paths) {
         return;
     }
+    if(max_path_count && all_paths->size() >= max_path_count) {
+        return;
+    }
 
     std::vector<int>* _path_to_use = NULL;
     if(path_so_far) {
@@ -186,6 +188,7 @@ void build_all_paths_from_pos_options(std::list<std::vector<int> >*
         (*_path_to_use)[word_index] = pos_index;
         build_all_paths_from_pos_options(all_paths,
                                          pos_table,
+                                         max_path_count,
                                          _path_to_use,
                                          word_index + 1);
     }
@@ -196,11 +199,86 @@ void build_all_paths_from_pos_options(std::list<std::vector<int> >*
     }
 }
 
-void build_pos_paths_from_sentence(std::list<std::vector<std::string> >*  all_paths_str, // OUT
-                                   std::string                            sentence,      // IN
-                                   std::stringstream                     &shared_info_messages)
+static void add_pos_path(std::list<std::vector<std::string> >*         all_paths_str,        // OUT
+                         const std::vector<std::vector<std::string> > &pos_table,            // IN
+                         const std::vector<int>                       &path,                 // IN
+                         uint64_t                                      path_index,           // IN
+                         std::stringstream                            &shared_info_messages)
 {
-    if(!all_paths_str) {
+    std::vector<std::string> path_str;
+    int word_index = 0;
+    for(std::vector<int>::const_iterator q = path.begin(); q != path.end(); q++) {
+        path_str.push_back(pos_table[word_index][*q]);
+        word_index++;
+    }
+
+    // print debug messages
+    {
+        int word_index = 0;
+        shared_info_messages << "INFO: Path #" << path_index << ": ";
+        for(std::vector<int>::const_iterator r = path.begin(); r != path.end(); r++) {
+            shared_info_messages << pos_table[word_index][*r];
+            if(r != --path.end()) {
+                shared_info_messages << " ";
+            }
+            word_index++;
+        }
+        shared_info_messages << std::endl;
+    }
+
+    all_paths_str->push_back(path_str);
+}
+
+bool build_pos_options_from_word(std::vector<std::string>* pos_options, // OUT
+                                 std::string*              word,        // OUT
+                                 const std::string        &token)       // IN
+{
+    if(!pos_options || !word) {
+        return false;
+    }
+
+    // "word/TAG" or "word/TAG1|TAG2" pins a word to the given tags
+    *word = token;
+    std::vector<std::string> pinned_tags;
+    size_t n = word->find('/');
+    if(n != std::string::npos && n != 0 && n + 1 < word->length()) {
+        pinned_tags = xl::tokenize(word->substr(n + 1), "|");
+        *word = word->substr(0, n);
+    }
+    const char* const* lexicon_tags = pinned_tags.size() ? NULL : get_pos_options(*word);
+    if(pinned_tags.size()) {
+        for(std::vector<std::string>::iterator q = pinned_tags.begin(); q != pinned_tags.end(); q++) {
+            pos_options->push_back(std::string("{") + *word + "}" + *q);
+        }
+    } else if(lexicon_tags) {
+        for(const char* const* q = lexicon_tags; *q; q++) {
+            pos_options->push_back(std::string("{") + *word + "}" + *q);
+        }
+    } else {
+        pos_options->push_back(std::string("{") + *word + "}" + *word);
+    }
+    return pinned_tags.size() != 0;
+}
+
+uint64_t count_pos_paths(const std::vector<std::vector<std::string> > &pos_table)
+{
+    uint64_t path_count = 1;
+    for(std::vector<std::vector<std::string> >::const_iterator p = pos_table.begin(); p != pos_table.end(); p++) {
+        uint64_t pos_option_count = (*p).size();
+        if(pos_option_count && path_count > std::numeric_limits<uint64_t>::max() / pos_option_count) {
+            return std::numeric_limits<uint64_t>::max();
+        }
+        path_count *= pos_option_count;
+    }
+    return path_count;
+}
+
+void build_pos_table_from_sentence(std::vector<std::vector<std::string> >* pos_table,            // OUT
+                                   const std::string                      &sentence,             // IN
+                                   std::stringstream                      &shared_info_messages,
+                                   bool                                    use_pos_rules)
+{
+    if(!pos_table) {
         return;
     }
 
@@ -211,38 +289,44 @@ void build_pos_paths_from_sentence(std::list<std::vector<std::string> >*  all_pa
     }
 
     // populate pos_table from words
-    std::vector<std::vector<std::string> > pos_table;
     std::vector<std::string> words = xl::tokenize(sentence);
-    pos_table.resize(words.size());
+    pos_table->resize(words.size());
     int word_index = 0;
     for(std::vector<std::string>::iterator p = words.begin(); p != words.end(); p++) {
-        std::vector<std::string> pos_options;
-        if(get_pos_options(*p, &pos_options)) {
-            for(std::vector<std::string>::iterator q = pos_options.begin(); q != pos_options.end(); q++) {
-                pos_table[word_index].push_back(std::string("{") + *p + "}" + *q);
-            }
-        } else {
-            pos_table[word_index].push_back(std::string("{") + *p + "}" + *p);
-        }
+        std::string word;
+        bool pinned = build_pos_options_from_word(&(*pos_table)[word_index], &word, *p);
 
         // print debug messages
         {
-            shared_info_messages << "INFO: {" << *p << "}:\t";
-            if(pos_options.size()) {
-                for(std::vector<std::string>::iterator r = pos_options.begin(); r != pos_options.end(); r++) {
-                    shared_info_messages << *r;
-                    if(r != --pos_options.end()) {
-                        shared_info_messages << " ";
-                    }
+            shared_info_messages << "INFO: {" << word << "}:\t";
+            const std::vector<std::string> &pos_options = (*pos_table)[word_index];
+            for(std::vector<std::string>::const_iterator r = pos_options.begin(); r != pos_options.end(); r++) {
+                shared_info_messages << (*r).substr(word.length() + 2);
+                if(r + 1 != pos_options.end()) {
+                    shared_info_messages << " ";
                 }
-            } else {
-                shared_info_messages << *p;
+            }
+            if(pinned) {
+                shared_info_messages << " (pinned)";
             }
             shared_info_messages << std::endl;
         }
 
         word_index++;
     }
+    if(use_pos_rules) {
+        apply_pos_rules(pos_table, shared_info_messages);
+    }
+}
+
+void build_pos_paths_from_pos_table(std::list<std::vector<std::string> >*         all_paths_str,        // OUT
+                                    const std::vector<std::vector<std::string> > &pos_table,            // IN
+                                    std::stringstream                            &shared_info_messages,
+                                    size_t                                        max_path_count)
+{
+    if(!all_paths_str) {
+        return;
+    }
 
     {
         std::string msg = "Step 2/4. Enumerate POS-paths:";
@@ -252,35 +336,364 @@ void build_pos_paths_from_sentence(std::list<std::vector<std::string> >*  all_pa
 
     // populate all_paths from pos_table
     std::list<std::vector<int> > all_paths;
-    build_all_paths_from_pos_options(&all_paths, pos_table);
+    build_all_paths_from_pos_options(&all_paths, pos_table, max_path_count);
 
     // populate all_paths_str from all_paths and print results
-    int path_index = 0;
+    uint64_t path_index = 0;
     for(std::list<std::vector<int> >::const_iterator p = all_paths.begin(); p != all_paths.end(); p++) {
-        std::vector<std::string> path_str;
-        const std::vector<int> &path = *p;
+        add_pos_path(all_paths_str, pos_table, *p, path_index, shared_info_messages);
+        path_index++;
+    }
+}
 
-        int word_index = 0;
-        for(std::vector<int>::const_iterator q = path.begin(); q != path.end(); q++) {
-            path_str.push_back(pos_table[word_index][*q]);
-            word_index++;
+// mixed-radix decode, the last word varying fastest as in build_all_paths_from_pos_options
+bool decode_path_index(const std::vector<std::vector<std::string> > &pos_table,
+                       uint64_t                                      path_index,
+                       std::vector<int>*                             path)
+{
+    if(!path) {
+        return false;
+    }
+    path->resize(pos_table.size());
+    for(int word_index = static_cast<int>(pos_table.size()) - 1; word_index >= 0; word_index--) {
+        uint64_t pos_option_count = pos_table[word_index].size();
+        (*path)[word_index] = static_cast<int>(path_index % pos_option_count);
+        path_index /= pos_option_count;
+    }
+    return !path_index; // left over digits mean the index is past the last path
+}
+
+void sample_path_indices(std::vector<uint64_t>* path_indices,
+                         uint64_t               path_count,
+                         size_t                 sample_count,
+                         uint64_t               seed)
+{
+    if(!path_indices) {
+        return;
+    }
+    path_indices->clear();
+    if(sample_count >= path_count) {
+        for(uint64_t i = 0; i < path_count; i++) {
+            path_indices->push_back(i);
         }
+        return;
+    }
 
-        // print debug messages
-        {
-            int word_index = 0;
-            shared_info_messages << "INFO: Path #" << path_index << ": ";
-            for(std::vector<int>::const_iterator r = path.begin(); r != path.end(); r++) {
-                shared_info_messages << pos_table[word_index][*r];
-                if(r != --path.end()) {
-                    shared_info_messages << " ";
+    // Floyd's algorithm: sample_count distinct draws, no rejection loop
+    std::mt19937_64 rng(seed);
+    std::set<uint64_t> chosen;
+    for(uint64_t j = path_count - sample_count; j < path_count; j++) {
+        uint64_t t = std::uniform_int_distribution<uint64_t>(0, j)(rng);
+        if(!chosen.insert(t).second) {
+            chosen.insert(j);
+        }
+    }
+    path_indices->assign(chosen.begin(), chosen.end());
+}
+
+// the indices a full run would give the same paths, so shards merge by index
+void range_path_indices(std::vector<uint64_t>* path_indices,
+                        uint64_t               path_count,
+                        uint64_t               start,
+                        uint64_t               end,
+                        size_t                 max_path_count)
+{
+    if(!path_indices) {
+        return;
+    }
+    path_indices->clear();
+    end = std::min(end, path_count);
+    if(max_path_count && start < end && end - start > max_path_count) {
+        end = start + max_path_count;
+    }
+    for(uint64_t i = start; i < end; i++) {
+        path_indices->push_back(i);
+    }
+}
+
+void build_pos_paths_from_path_indices(std::list<std::vector<std::string> >*         all_paths_str,        // OUT
+                                       const std::vector<std::vector<std::string> > &pos_table,            // IN
+                                       const std::vector<uint64_t>                  &path_indices,         // IN
+                                       std::stringstream                            &shared_info_messages)
+{
+    if(!all_paths_str) {
+        return;
+    }
+
+    {
+        std::string msg = "Step 2/4. Enumerate POS-paths:";
+        std::string bar = std::string(msg.length(), '=');
+        shared_info_messages << std::endl << bar << std::endl << msg << std::endl << bar << std::endl << std::endl;
+    }
+
+    std::vector<int> path;
+    for(std::vector<uint64_t>::const_iterator p = path_indices.begin(); p != path_indices.end(); p++) {
+        decode_path_index(pos_table, *p, &path);
+        add_pos_path(all_paths_str, pos_table, path, *p, shared_info_messages);
+    }
+}
+
+void build_pos_paths_from_sentence(std::list<std::vector<std::string> >*  all_paths_str, // OUT
+                                   const std::string                     &sentence,      // IN
+                                   std::stringstream                     &shared_info_messages,
+                                   bool                                   use_pos_rules)
+{
+    std::vector<std::vector<std::string> > pos_table;
+    build_pos_table_from_sentence(&pos_table, sentence, shared_info_messages, use_pos_rules);
+    build_pos_paths_from_pos_table(all_paths_str, pos_table, shared_info_messages);
+}
+
+bool load_pos_stats(pos_stats_table_t* pos_stats_table, const std::string &filename)
+{
+    if(!pos_stats_table) {
+        return false;
+    }
+    std::ifstream ifs(filename.c_str());
+    if(!ifs.is_open()) {
+        return false;
+    }
+    read_pos_stats(pos_stats_table, ifs);
+    return true;
+}
+
+bool save_pos_stats(const pos_stats_table_t &pos_stats_table, const std::string &filename)
+{
+    std::ofstream ofs(filename.c_str());
+    if(!ofs.is_open()) {
+        return false;
+    }
+    write_pos_stats(pos_stats_table, ofs);
+    return true;
+}
+
+void read_pos_stats(pos_stats_table_t* pos_stats_table, std::istream &is)
+{
+    std::string pos;
+    pos_stats_t pos_stats;
+    while(is >> pos >> pos_stats.m_hit_count >> pos_stats.m_try_count) {
+        (*pos_stats_table)[pos] = pos_stats;
+    }
+}
+
+void write_pos_stats(const pos_stats_table_t &pos_stats_table, std::ostream &os)
+{
+    for(pos_stats_table_t::const_iterator p = pos_stats_table.begin(); p != pos_stats_table.end(); p++) {
+        os << (*p).first << " " << (*p).second.m_hit_count << " " << (*p).second.m_try_count << std::endl;
+    }
+}
+
+void merge_pos_stats(pos_stats_table_t*       pos_stats_table,
+                     const pos_stats_table_t &delta)
+{
+    for(pos_stats_table_t::const_iterator p = delta.begin(); p != delta.end(); p++) {
+        pos_stats_t &pos_stats = (*pos_stats_table)[(*p).first];
+        pos_stats.m_hit_count += (*p).second.m_hit_count;
+        pos_stats.m_try_count += (*p).second.m_try_count;
+    }
+}
+
+void update_pos_stats(pos_stats_table_t*              pos_stats_table,
+                      const std::vector<std::string> &pos_path,
+                      bool                            success)
+{
+    if(!pos_stats_table) {
+        return;
+    }
+    for(std::vector<std::string>::const_iterator p = pos_path.begin(); p != pos_path.end(); p++) {
+        pos_stats_t &pos_stats = (*pos_stats_table)[*p];
+        if(success) {
+            pos_stats.m_hit_count++;
+        }
+        pos_stats.m_try_count++;
+    }
+}
+
+uint64_t encode_path(const std::vector<std::vector<std::string> > &pos_table,
+                     const std::vector<int>                       &path)
+{
+    uint64_t path_index = 0;
+    for(size_t word_index = 0; word_index < pos_table.size(); word_index++) {
+        path_index = path_index * pos_table[word_index].size() + path[word_index];
+    }
+    return path_index;
+}
+
+// Laplace-smoothed log success rate of every (word, tag) choice
+static void build_score_table(std::vector<std::vector<double> >*            score_table,     // OUT
+                              const std::vector<std::vector<std::string> > &pos_table,       // IN
+                              const pos_stats_table_t                      &pos_stats_table) // IN
+{
+    score_table->resize(pos_table.size());
+    for(size_t i = 0; i < pos_table.size(); i++) {
+        for(size_t j = 0; j < pos_table[i].size(); j++) {
+            double hit_count = 0;
+            double try_count = 0;
+            pos_stats_table_t::const_iterator p = pos_stats_table.find(pos_table[i][j]);
+            if(p != pos_stats_table.end()) {
+                hit_count = (*p).second.m_hit_count;
+                try_count = (*p).second.m_try_count;
+            }
+            (*score_table)[i].push_back(log((hit_count + 1) / (try_count + 2)));
+        }
+    }
+}
+
+struct best_first_node_t
+{
+    double           m_score;
+    uint64_t         m_path_index;
+    std::vector<int> m_ranks; // per word, into that word's options sorted best first
+    size_t           m_pivot; // only words from here on may be advanced, so each path is queued once
+
+    bool operator<(const best_first_node_t &other) const
+    {
+        if(m_score != other.m_score) {
+            return m_score < other.m_score;
+        }
+        return m_path_index > other.m_path_index; // ties in lattice order
+    }
+};
+
+void build_best_first_path_indices(std::vector<uint64_t>*                        path_indices,    // OUT
+                                   const std::vector<std::vector<std::string> > &pos_table,       // IN
+                                   const pos_stats_table_t                      &pos_stats_table, // IN
+                                   size_t                                        max_path_count)  // IN
+{
+    if(!path_indices) {
+        return;
+    }
+    path_indices->clear();
+
+    std::vector<std::vector<double> > score_table;
+    std::vector<std::vector<int> >    sorted_table(pos_table.size());
+    build_score_table(&score_table, pos_table, pos_stats_table);
+    for(size_t i = 0; i < pos_table.size(); i++) {
+        std::vector<std::pair<double, int> > sorted_options;
+        for(size_t j = 0; j < pos_table[i].size(); j++) {
+            sorted_options.push_back(std::make_pair(-score_table[i][j], static_cast<int>(j)));
+        }
+        std::stable_sort(sorted_options.begin(), sorted_options.end());
+        for(std::vector<std::pair<double, int> >::iterator q = sorted_options.begin(); q != sorted_options.end(); q++) {
+            sorted_table[i].push_back((*q).second);
+        }
+    }
+
+    std::priority_queue<best_first_node_t> queue;
+    std::vector<int> path(pos_table.size());
+    best_first_node_t start;
+    start.m_ranks.resize(pos_table.size());
+    start.m_pivot = 0;
+    for(size_t i = 0; i < pos_table.size(); i++) {
+        path[i] = sorted_table[i][0];
+    }
+    start.m_score      = 0;
+    start.m_path_index = encode_path(pos_table, path);
+    for(size_t i = 0; i < pos_table.size(); i++) {
+        start.m_score += score_table[i][path[i]];
+    }
+    queue.push(start);
+    while(!queue.empty() && (!max_path_count || path_indices->size() < max_path_count)) {
+        best_first_node_t node = queue.top();
+        queue.pop();
+        path_indices->push_back(node.m_path_index);
+        for(size_t i = node.m_pivot; i < pos_table.size(); i++) {
+            if(node.m_ranks[i] + 1 == static_cast<int>(sorted_table[i].size())) {
+                continue;
+            }
+            best_first_node_t next = node;
+            next.m_ranks[i]++;
+            next.m_pivot = i;
+            next.m_score = 0;
+            for(size_t j = 0; j < pos_table.size(); j++) {
+                path[j] = sorted_table[j][next.m_ranks[j]];
+                next.m_score += score_table[j][path[j]]; // summed in word order so equal paths tie exactly
+            }
+            next.m_path_index = encode_path(pos_table, path);
+            queue.push(next);
+        }
+    }
+}
+
+struct beam_item_t
+{
+    double           m_score;
+    int              m_parent;     // item index in the previous position's beam
+    int              m_pos_index;  // this word's option
+    std::vector<int> m_state_stack;
+
+    bool operator<(const beam_item_t &other) const
+    {
+        return m_score > other.m_score; // best first; stable sort keeps lattice order on ties
+    }
+};
+
+void build_beam_path_indices(std::vector<uint64_t>*                        path_indices,    // OUT
+                             const std::vector<std::vector<std::string> > &pos_table,       // IN
+                             const pos_stats_table_t                      &pos_stats_table, // IN
+                             size_t                                        beam_width)      // IN
+{
+    if(!path_indices) {
+        return;
+    }
+    path_indices->clear();
+    if(!beam_width) {
+        return;
+    }
+    std::vector<std::vector<double> > score_table;
+    build_score_table(&score_table, pos_table, pos_stats_table);
+
+    // one beam per word, linked by parent index so paths aren't copied
+    std::vector<std::vector<beam_item_t> > beams(pos_table.size() + 1);
+    beam_item_t start;
+    start.m_score     = 0;
+    start.m_parent    = -1;
+    start.m_pos_index = -1;
+    beams[0].push_back(start);
+    for(size_t word_index = 0; word_index < pos_table.size(); word_index++) {
+        std::vector<uint32_t> lexer_ids;
+        for(std::vector<std::string>::const_iterator p = pos_table[word_index].begin(); p != pos_table[word_index].end(); p++) {
+            lexer_ids.push_back(pos_to_lexer_id(*p));
+        }
+        std::vector<beam_item_t> &beam      = beams[word_index];
+        std::vector<beam_item_t> &next_beam = beams[word_index + 1];
+        for(size_t i = 0; i < beam.size(); i++) {
+            for(size_t j = 0; j < lexer_ids.size(); j++) {
+                if(!lexer_ids[j]) {
+                    continue;
+                }
+                beam_item_t next;
+                next.m_state_stack = beam[i].m_state_stack;
+                if(!lr_advance(&next.m_state_stack, lexer_ids[j])) {
+                    continue; // the parser would reject this tag here
                 }
-                word_index++;
+                next.m_score     = beam[i].m_score + score_table[word_index][j];
+                next.m_parent    = static_cast<int>(i);
+                next.m_pos_index = static_cast<int>(j);
+                next_beam.push_back(next);
             }
-            shared_info_messages << std::endl;
         }
+        std::stable_sort(next_beam.begin(), next_beam.end());
+        if(next_beam.size() > beam_width) {
+            next_beam.resize(beam_width);
+        }
+        for(std::vector<beam_item_t>::iterator q = beam.begin(); q != beam.end(); q++) {
+            std::vector<int>().swap((*q).m_state_stack); // only the last beam's stacks are needed
+        }
+    }
 
-        all_paths_str->push_back(path_str);
-        path_index++;
+    // keep the complete paths the parser accepts
+    std::vector<beam_item_t> &last_beam = beams[pos_table.size()];
+    std::vector<int> path(pos_table.size());
+    for(size_t i = 0; i < last_beam.size(); i++) {
+        if(!lr_advance(&last_beam[i].m_state_stack, 0)) {
+            continue;
+        }
+        int item_index = static_cast<int>(i);
+        for(int word_index = static_cast<int>(pos_table.size()); word_index > 0; word_index--) {
+            const beam_item_t &item = beams[word_index][item_index];
+            path[word_index - 1] = item.m_pos_index;
+            item_index = item.m_parent;
+        }
+        path_indices->push_back(encode_path(pos_table, path));
     }
 }
@@ -21,14 +21,18 @@
 
 #include "parse-english.h"
 #include "node/XLangNodeIFace.h" // node::NodeIdentIFace
+#include "node/XLangFlatTree.h" // node::FlatTree
 #include "parse-englishLexerIDWrapper.h" // ID_XXX (yacc generated)
 #include "XLangAlloc.h" // Allocator
 #include "mvc/XLangMVCView.h" // mvc::MVCView
 #include "mvc/XLangMVCModel.h" // mvc::MVCModel
 #include "XLangTreeContext.h" // TreeContext
+#include "XLangConsContext.h" // ConsContext
 #include "XLangString.h" // xl::replace
 #include "XLangType.h" // uint32_t
 #include "TryAllParses.h" // gen_variations
+#include "ParseSession.h" // ParseSession
+#include "XLangBoundedQueue.h" // BoundedQueue
 #include "visitor/XLangVisitor.h" // visitor::Visitor
 #include <Ontology.h> // NodeGatherer
 #include <stdio.h> // size_t
@@ -36,25 +40,46 @@
 #include <string.h> // strlen
 #include <vector> // std::vector
 #include <list> // std::list
+#include <deque> // std::deque
 #include <map> // std::map
 #include <string> // std::string
 #include <sstream> // std::stringstream
 #include <iostream> // std::cout
-#include <stdlib.h> // EXIT_SUCCESS
+#include <fstream> // std::ifstream
+#include <algorithm> // std::sort
+#include <limits> // std::numeric_limits
+#include <stdlib.h> // EXIT_SUCCESS, atoi, strtoull
 #include <getopt.h> // getopt_long
 #include <pthread.h> // pthread_t
+#include <atomic> // std::atomic
+#include <time.h> // clock_gettime
+#include <errno.h> // ETIMEDOUT
+#include <unistd.h> // fork, usleep, sysconf
+#include <sys/mman.h> // mmap
+#include <sys/wait.h> // waitpid
+#include <poll.h> // poll
 
 #define DEBUG
 
-#define MAKE_TERM(lexer_id, ...)   xl::mvc::MVCModel::make_term(&pc->tree_context(), lexer_id, ##__VA_ARGS__)
-#define MAKE_SYMBOL(...)           xl::mvc::MVCModel::make_symbol(&pc->tree_context(), ##__VA_ARGS__)
+#define MAKE_TERM(lexer_id, ...)   pc->tree_builder().make_term(lexer_id, ##__VA_ARGS__)
+#define MAKE_SYMBOL(...)           pc->tree_builder().make_symbol(__VA_ARGS__)
+#define APPEND_SYMBOL(...)         pc->tree_builder().append_symbol(__VA_ARGS__)
 #define ERROR_LEXER_ID_NOT_FOUND   "Missing lexer id handler. Did you forgot to register one?"
 #define ERROR_LEXER_NAME_NOT_FOUND "Missing lexer name handler. Did you forgot to register one?"
 
 #define NTHREADS 4
+#define MAX_PATH_COUNT 65536
+#define PIPELINE_DEPTH 2 // sentences queued between pipeline stages
+#define SCHEDULE_WINDOW 64 // tagged sentences the scheduler picks the cheapest from
+#define SCHEDULE_AGING 8 // passes over a sentence that halve its estimated cost
+#define WORKER_TASK_SLOTS 2 // sentences queued per worker, counting the one it parses
+#define WORKER_TASK_BYTES 4096 // longest sentence a worker can be sent
+#define WORKER_RING_BYTES (1 << 20) // result ring per worker
+#define WORKER_POLL_US 100 // rings are polled; see worker_channel_t
 pthread_t threads[NTHREADS];
 void* retvals[NTHREADS];
 pthread_mutex_t graph_mutex;
+pthread_mutex_t cons_mutex;
 
 // report error
 void yyerror(YYLTYPE* loc, ParserContext* pc, yyscan_t scanner, const char* s)
@@ -249,21 +274,21 @@ static std::string expand_contractions(std::string &sentence)
 //==============
 
 // rules for internal nodes
-%type<symbol_value> S S_PUNC STMT QUERY COND CMD CLAUSE QCLAUSE
-                    NP POSS VP QVP CVP CMP
-                    AUX_V CAUX_V AUX_NOT_V AUX_NP_V
-                        V_NP     VPAST_NP DET_ADJ_N     VGERUND_NP                 PREP_NP
-                    ADV_V_NP ADV_VPAST_NP           ADV_VGERUND_NP ADV_HAVE_TARGET
-                    INFIN V_INFIN
-                    ADJ_N ADV_ADJ
-                    BE_TARGET      HAVE_TARGET      MODAL_TARGET      DO_TARGET OPT_BE_TARGET FREQ_DO_TARGET
-                    BE_NOT         HAVE_NOT         MODAL_NOT         DO_NOT
-                    BE_NP          HAVE_NP          MODAL_NP          DO_NP
-                    BE_NOT_OR_FREQ HAVE_NOT_OR_FREQ MODAL_NOT_OR_FREQ DO_NOT_OR_FREQ TO_NOT_OR_FREQ
-                    S_LIST CLAUSE_LIST QCLAUSE_LIST CVP_LIST      NP_LIST      VP_LIST      ADJ_LIST      PREP_LIST POSS_LIST
-                                                             CONJ_NP_NOT  CONJ_VP_NOT  CONJ_ADJ_NOT  CONJ_PREP_NOT
-                    WHPRON
-                    NOT_OR_FREQ EOS
+%type<ast_value> S S_PUNC STMT QUERY COND CMD CLAUSE QCLAUSE
+                 NP POSS VP QVP CVP CMP
+                 AUX_V CAUX_V AUX_NOT_V AUX_NP_V
+                     V_NP     VPAST_NP DET_ADJ_N     VGERUND_NP                 PREP_NP
+                 ADV_V_NP ADV_VPAST_NP           ADV_VGERUND_NP ADV_HAVE_TARGET
+                 INFIN V_INFIN
+                 ADJ_N ADV_ADJ
+                 BE_TARGET      HAVE_TARGET      MODAL_TARGET      DO_TARGET OPT_BE_TARGET FREQ_DO_TARGET
+                 BE_NOT         HAVE_NOT         MODAL_NOT         DO_NOT
+                 BE_NP          HAVE_NP          MODAL_NP          DO_NP
+                 BE_NOT_OR_FREQ HAVE_NOT_OR_FREQ MODAL_NOT_OR_FREQ DO_NOT_OR_FREQ TO_NOT_OR_FREQ
+                 S_LIST CLAUSE_LIST QCLAUSE_LIST CVP_LIST      NP_LIST      VP_LIST      ADJ_LIST      PREP_LIST POSS_LIST
+                                                          CONJ_NP_NOT  CONJ_VP_NOT  CONJ_ADJ_NOT  CONJ_PREP_NOT
+                 WHPRON
+                 NOT_OR_FREQ EOS
 
 // IDs for internal nodes
 %nonassoc           ID_S ID_S_PUNC ID_STMT ID_QUERY ID_COND ID_CMD ID_CLAUSE ID_QCLAUSE
@@ -298,15 +323,15 @@ static std::string expand_contractions(std::string &sentence)
                     ID_NOT ID_FREQ ID_FREQ_EOS ID_TOO ID_PUNC
 
 // rules for terminals
-%type<symbol_value> N V VPAST VGERUND GOING_MOD_INFIN VPASTPERF V_MOD_INFIN ADJ ADV_MOD_ADJ ADV_MOD_V ADV_MOD_VGERUND_PRE ADV_MOD_VGERUND_POST PREP
-                    DEM EVERY NONE ART_OR_PREFIXPOSS SUFFIXPOSS
-                    BEING BEEN
-                    BE CBE HAVE MODAL DO TO_MOD_V
-                    CONJ_CLAUSE CONJ_NP CONJ_VP CONJ_ADJ CONJ_PREP
-                    WHWORD WHWORD_MOD_THAT
-                    CMPWORD CMPWORD_EST THAN CMP_AS CMP_LIKE MOST MORE
-                    IF THEN BECAUSE
-                    NOT FREQ FREQ_EOS TOO PUNC
+%type<ast_value> N V VPAST VGERUND GOING_MOD_INFIN VPASTPERF V_MOD_INFIN ADJ ADV_MOD_ADJ ADV_MOD_V ADV_MOD_VGERUND_PRE ADV_MOD_VGERUND_POST PREP
+                 DEM EVERY NONE ART_OR_PREFIXPOSS SUFFIXPOSS
+                 BEING BEEN
+                 BE CBE HAVE MODAL DO TO_MOD_V
+                 CONJ_CLAUSE CONJ_NP CONJ_VP CONJ_ADJ CONJ_PREP
+                 WHWORD WHWORD_MOD_THAT
+                 CMPWORD CMPWORD_EST THAN CMP_AS CMP_LIKE MOST MORE
+                 IF THEN BECAUSE
+                 NOT FREQ FREQ_EOS TOO PUNC
 
 %%
 
@@ -315,148 +340,148 @@ static std::string expand_contractions(std::string &sentence)
 //==============
 
 root:
-      S_LIST { pc->tree_context().root() = $1; YYACCEPT; }
+      S_LIST { pc->tree_builder().set_root($1); YYACCEPT; }
     | error  { yyclearin; /* yyerrok; YYABORT; */ }
     ;
 
 S_PUNC:
-      S     PUNC { $$ = MAKE_SYMBOL(ID_S_PUNC, 2, $1, $2); }
-    | S EOS PUNC { $$ = MAKE_SYMBOL(ID_S_PUNC, 3, $1, $2, $3); }
+      S     PUNC { $$ = MAKE_SYMBOL(ID_S_PUNC, $1, $2); }
+    | S EOS PUNC { $$ = MAKE_SYMBOL(ID_S_PUNC, $1, $2, $3); }
     ;
 
 S:
-      STMT  { $$ = MAKE_SYMBOL(ID_S, 1, $1); }
-    | QUERY { $$ = MAKE_SYMBOL(ID_S, 1, $1); }
-    | COND  { $$ = MAKE_SYMBOL(ID_S, 1, $1); }
-    | CMD   { $$ = MAKE_SYMBOL(ID_S, 1, $1); }
+      STMT  { $$ = MAKE_SYMBOL(ID_S, $1); }
+    | QUERY { $$ = MAKE_SYMBOL(ID_S, $1); }
+    | COND  { $$ = MAKE_SYMBOL(ID_S, $1); }
+    | CMD   { $$ = MAKE_SYMBOL(ID_S, $1); }
     ;
 
 STMT:
-      CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_STMT, 1, $1); }
+      CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_STMT, $1); }
     ;
 
 QUERY:
-      QCLAUSE_LIST { $$ = MAKE_SYMBOL(ID_QUERY, 1, $1); }
+      QCLAUSE_LIST { $$ = MAKE_SYMBOL(ID_QUERY, $1); }
     ;
 
 COND:
-      IF      CLAUSE_LIST THEN        CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_COND, 4, $1, $2, $3, $4); } // if you build it then he will come
-    |         CLAUSE_LIST IF          CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_COND, 3, $1, $2, $3); }     // he will come if you build it
-    | BECAUSE CLAUSE_LIST CONJ_CLAUSE CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_COND, 4, $1, $2, $3, $4); } // because you built it, he will come
-    |         CLAUSE_LIST BECAUSE     CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_COND, 3, $1, $2, $3); }     // he will come because you built it
-    |         AUX_NP_V    CONJ_CLAUSE CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_COND, 3, $1, $2, $3); }     // had you built it, he would have come 
+      IF      CLAUSE_LIST THEN        CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_COND, $1, $2, $3, $4); } // if you build it then he will come
+    |         CLAUSE_LIST IF          CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_COND, $1, $2, $3); }     // he will come if you build it
+    | BECAUSE CLAUSE_LIST CONJ_CLAUSE CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_COND, $1, $2, $3, $4); } // because you built it, he will come
+    |         CLAUSE_LIST BECAUSE     CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_COND, $1, $2, $3); }     // he will come because you built it
+    |         AUX_NP_V    CONJ_CLAUSE CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_COND, $1, $2, $3); }     // had you built it, he would have come 
     ;
 
 CMD:
-      CVP_LIST { $$ = MAKE_SYMBOL(ID_CMD, 1, $1); }
+      CVP_LIST { $$ = MAKE_SYMBOL(ID_CMD, $1); }
     ;
 
 CLAUSE:
-                            NP_LIST VP_LIST           { $$ = MAKE_SYMBOL(ID_CLAUSE, 2, $1, $2); }         // he goes
-    | PREP_LIST CONJ_CLAUSE NP_LIST VP_LIST           { $$ = MAKE_SYMBOL(ID_CLAUSE, 4, $1, $2, $3, $4); } // from there, he went
-    |                       NP_LIST VP_LIST PREP_LIST { $$ = MAKE_SYMBOL(ID_CLAUSE, 3, $1, $2, $3); }     //
+                            NP_LIST VP_LIST           { $$ = MAKE_SYMBOL(ID_CLAUSE, $1, $2); }         // he goes
+    | PREP_LIST CONJ_CLAUSE NP_LIST VP_LIST           { $$ = MAKE_SYMBOL(ID_CLAUSE, $1, $2, $3, $4); } // from there, he went
+    |                       NP_LIST VP_LIST PREP_LIST { $$ = MAKE_SYMBOL(ID_CLAUSE, $1, $2, $3); }     //
     ;
 
 QCLAUSE:
-             QVP { $$ = MAKE_SYMBOL(ID_QCLAUSE, 1, $1); }     // he did it?
-    | WHWORD QVP { $$ = MAKE_SYMBOL(ID_QCLAUSE, 2, $1, $2); } // who did it?
+             QVP { $$ = MAKE_SYMBOL(ID_QCLAUSE, $1); }     // he did it?
+    | WHWORD QVP { $$ = MAKE_SYMBOL(ID_QCLAUSE, $1, $2); } // who did it?
     ;
 
 //=============================================================================
 // NOUN PART -- VERB PART
 
 NP:
-      POSS           { $$ = MAKE_SYMBOL(ID_NP, 1, $1); }         // the/my father
-    | ADV_VGERUND_NP { $$ = MAKE_SYMBOL(ID_NP, 1, $1); }         // quickly going there
-    | INFIN          { $$ = MAKE_SYMBOL(ID_NP, 1, $1); }         // to go there
-    | WHPRON VP      { $$ = MAKE_SYMBOL(ID_NP, 2, $1, $2); }     // who (pronoun) was there
-    | WHPRON NP VP   { $$ = MAKE_SYMBOL(ID_NP, 3, $1, $2, $3); } // who (pronoun) he is
-    | PREP_LIST      { $$ = MAKE_SYMBOL(ID_NP, 1, $1); }         // from here and there
-    | CMP NP         { $$ = MAKE_SYMBOL(ID_NP, 2, $1, $2); }     // bigger than he
+      POSS           { $$ = MAKE_SYMBOL(ID_NP, $1); }         // the/my father
+    | ADV_VGERUND_NP { $$ = MAKE_SYMBOL(ID_NP, $1); }         // quickly going there
+    | INFIN          { $$ = MAKE_SYMBOL(ID_NP, $1); }         // to go there
+    | WHPRON VP      { $$ = MAKE_SYMBOL(ID_NP, $1, $2); }     // who (pronoun) was there
+    | WHPRON NP VP   { $$ = MAKE_SYMBOL(ID_NP, $1, $2, $3); } // who (pronoun) he is
+    | PREP_LIST      { $$ = MAKE_SYMBOL(ID_NP, $1); }         // from here and there
+    | CMP NP         { $$ = MAKE_SYMBOL(ID_NP, $1, $2); }     // bigger than he
     ;
 
 POSS:
-      DET_ADJ_N                      { $$ = MAKE_SYMBOL(ID_POSS, 1, $1); }         // the/my red apple
-    | DET_ADJ_N SUFFIXPOSS POSS_LIST { $$ = MAKE_SYMBOL(ID_POSS, 3, $1, $2, $3); } // the/my father's mother's sister
-    |                      POSS_LIST { $$ = MAKE_SYMBOL(ID_POSS, 1, $1); }         // father's mother's sister
+      DET_ADJ_N                      { $$ = MAKE_SYMBOL(ID_POSS, $1); }         // the/my red apple
+    | DET_ADJ_N SUFFIXPOSS POSS_LIST { $$ = MAKE_SYMBOL(ID_POSS, $1, $2, $3); } // the/my father's mother's sister
+    |                      POSS_LIST { $$ = MAKE_SYMBOL(ID_POSS, $1); }         // father's mother's sister
     ;
 
 VP:
-        AUX_NOT_V                      { $$ = MAKE_SYMBOL(ID_VP, 1, $1); }     // is going there
-    | MODAL_NOT_OR_FREQ   MODAL_TARGET { $$ = MAKE_SYMBOL(ID_VP, 2, $1, $2); } // can go there
-    |    DO_NOT_OR_FREQ      DO_TARGET { $$ = MAKE_SYMBOL(ID_VP, 2, $1, $2); } // does go there
-    |                   FREQ_DO_TARGET { $$ = MAKE_SYMBOL(ID_VP, 1, $1); }     // always goes there
-    |                     ADV_VPAST_NP { $$ = MAKE_SYMBOL(ID_VP, 1, $1); }     // quickly went there
+        AUX_NOT_V                      { $$ = MAKE_SYMBOL(ID_VP, $1); }     // is going there
+    | MODAL_NOT_OR_FREQ   MODAL_TARGET { $$ = MAKE_SYMBOL(ID_VP, $1, $2); } // can go there
+    |    DO_NOT_OR_FREQ      DO_TARGET { $$ = MAKE_SYMBOL(ID_VP, $1, $2); } // does go there
+    |                   FREQ_DO_TARGET { $$ = MAKE_SYMBOL(ID_VP, $1); }     // always goes there
+    |                     ADV_VPAST_NP { $$ = MAKE_SYMBOL(ID_VP, $1); }     // quickly went there
     ;
 
 QVP:
-        AUX_NP_V              { $$ = MAKE_SYMBOL(ID_QVP, 1, $1); }     // is he going?
-    | MODAL_NP   MODAL_TARGET { $$ = MAKE_SYMBOL(ID_QVP, 2, $1, $2); } // can he go?
-    |    DO_NP      DO_TARGET { $$ = MAKE_SYMBOL(ID_QVP, 2, $1, $2); } // does he go?
+        AUX_NP_V              { $$ = MAKE_SYMBOL(ID_QVP, $1); }     // is he going?
+    | MODAL_NP   MODAL_TARGET { $$ = MAKE_SYMBOL(ID_QVP, $1, $2); } // can he go?
+    |    DO_NP      DO_TARGET { $$ = MAKE_SYMBOL(ID_QVP, $1, $2); } // does he go?
     ;
 
 CVP:
-      CAUX_V                        { $$ = MAKE_SYMBOL(ID_CVP, 1, $1); }     // be there!
-    | DO_NOT_OR_FREQ      DO_TARGET { $$ = MAKE_SYMBOL(ID_CVP, 2, $1, $2); } // do go there!
-    |                FREQ_DO_TARGET { $$ = MAKE_SYMBOL(ID_CVP, 1, $1); }     // always go there!
+      CAUX_V                        { $$ = MAKE_SYMBOL(ID_CVP, $1); }     // be there!
+    | DO_NOT_OR_FREQ      DO_TARGET { $$ = MAKE_SYMBOL(ID_CVP, $1, $2); } // do go there!
+    |                FREQ_DO_TARGET { $$ = MAKE_SYMBOL(ID_CVP, $1); }     // always go there!
     ;
 
 CMP:
-      CMPWORD THAN      { $$ = MAKE_SYMBOL(ID_CMP, 2, $1, $2); }     // bigger than
-    | MORE ADJ THAN     { $$ = MAKE_SYMBOL(ID_CMP, 3, $1, $2, $3); } // more big than
-    | CMP_AS ADJ CMP_AS { $$ = MAKE_SYMBOL(ID_CMP, 3, $1, $2, $3); } // as big as
-    | ADJ CMP_LIKE      { $$ = MAKE_SYMBOL(ID_CMP, 2, $1, $2); }     // big like
+      CMPWORD THAN      { $$ = MAKE_SYMBOL(ID_CMP, $1, $2); }     // bigger than
+    | MORE ADJ THAN     { $$ = MAKE_SYMBOL(ID_CMP, $1, $2, $3); } // more big than
+    | CMP_AS ADJ CMP_AS { $$ = MAKE_SYMBOL(ID_CMP, $1, $2, $3); } // as big as
+    | ADJ CMP_LIKE      { $$ = MAKE_SYMBOL(ID_CMP, $1, $2); }     // big like
     ;
 
 //=============================================================================
 // AUXILIARY VERB
 
 AUX_V:
-           BE     OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_V, 2, $1, $2); }     // be there
-    | HAVE BEEN   OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_V, 3, $1, $2, $3); } // has been there
-    | HAVE      ADV_HAVE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_V, 2, $1, $2); }     // has quickly gone there
+           BE     OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_V, $1, $2); }     // be there
+    | HAVE BEEN   OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_V, $1, $2, $3); } // has been there
+    | HAVE      ADV_HAVE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_V, $1, $2); }     // has quickly gone there
     ;
 
 CAUX_V:
-      CBE OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_CAUX_V, 2, $1, $2); } // be there!
+      CBE OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_CAUX_V, $1, $2); } // be there!
     ;
 
 AUX_NOT_V:
-                       BE_NOT_OR_FREQ   OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NOT_V, 2, $1, $2); }     // is not there
-    | HAVE_NOT_OR_FREQ BEEN             OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NOT_V, 3, $1, $2, $3); } // has not been there
-    | HAVE_NOT_OR_FREQ                ADV_HAVE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NOT_V, 2, $1, $2); }     // has not quickly gone there
+                       BE_NOT_OR_FREQ   OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NOT_V, $1, $2); }     // is not there
+    | HAVE_NOT_OR_FREQ BEEN             OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NOT_V, $1, $2, $3); } // has not been there
+    | HAVE_NOT_OR_FREQ                ADV_HAVE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NOT_V, $1, $2); }     // has not quickly gone there
     ;
 
 AUX_NP_V:
-              BE_NP   OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NP_V, 2, $1, $2); }     // is he there?
-    | HAVE_NP BEEN    OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NP_V, 3, $1, $2, $3); } // has he been there?
-    | HAVE_NP       ADV_HAVE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NP_V, 2, $1, $2); }     // has he quickly gone there?
+              BE_NP   OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NP_V, $1, $2); }     // is he there?
+    | HAVE_NP BEEN    OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NP_V, $1, $2, $3); } // has he been there?
+    | HAVE_NP       ADV_HAVE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NP_V, $1, $2); }     // has he quickly gone there?
     ;
 
 //=============================================================================
 // VERB
 
 V_NP:
-      V            { $$ = MAKE_SYMBOL(ID_V_NP, 1, $1); }         // go
-    | V NP_LIST    { $$ = MAKE_SYMBOL(ID_V_NP, 2, $1, $2); }     // go there
-    | V NP      NP { $$ = MAKE_SYMBOL(ID_V_NP, 3, $1, $2, $3); } // give him it
+      V            { $$ = MAKE_SYMBOL(ID_V_NP, $1); }         // go
+    | V NP_LIST    { $$ = MAKE_SYMBOL(ID_V_NP, $1, $2); }     // go there
+    | V NP      NP { $$ = MAKE_SYMBOL(ID_V_NP, $1, $2, $3); } // give him it
     ;
 
 VPAST_NP:
-      VPAST            { $$ = MAKE_SYMBOL(ID_VPAST_NP, 1, $1); }         // went
-    | VPAST NP_LIST    { $$ = MAKE_SYMBOL(ID_VPAST_NP, 2, $1, $2); }     // went there
-    | VPAST NP      NP { $$ = MAKE_SYMBOL(ID_VPAST_NP, 3, $1, $2, $3); } // gave him it
+      VPAST            { $$ = MAKE_SYMBOL(ID_VPAST_NP, $1); }         // went
+    | VPAST NP_LIST    { $$ = MAKE_SYMBOL(ID_VPAST_NP, $1, $2); }     // went there
+    | VPAST NP      NP { $$ = MAKE_SYMBOL(ID_VPAST_NP, $1, $2, $3); } // gave him it
     ;
 
 VGERUND_NP:
-      VGERUND                  { $$ = MAKE_SYMBOL(ID_VGERUND_NP, 1, $1); }         // going
-    | VGERUND NP_LIST          { $$ = MAKE_SYMBOL(ID_VGERUND_NP, 2, $1, $2); }     // going there
-    | VGERUND NP            NP { $$ = MAKE_SYMBOL(ID_VGERUND_NP, 3, $1, $2, $3); } // giving him it
-    | BEING   OPT_BE_TARGET    { $$ = MAKE_SYMBOL(ID_VGERUND_NP, 2, $1, $2); }     // being there
+      VGERUND                  { $$ = MAKE_SYMBOL(ID_VGERUND_NP, $1); }         // going
+    | VGERUND NP_LIST          { $$ = MAKE_SYMBOL(ID_VGERUND_NP, $1, $2); }     // going there
+    | VGERUND NP            NP { $$ = MAKE_SYMBOL(ID_VGERUND_NP, $1, $2, $3); } // giving him it
+    | BEING   OPT_BE_TARGET    { $$ = MAKE_SYMBOL(ID_VGERUND_NP, $1, $2); }     // being there
     ;
 
 PREP_NP:
-      PREP NP_LIST { $$ = MAKE_SYMBOL(ID_PREP_NP, 2, $1, $2); } // from there
+      PREP NP_LIST { $$ = MAKE_SYMBOL(ID_PREP_NP, $1, $2); } // from there
                                                                 // NOTE: using NP_LIST here causes shift-reduce conflict because NP ==> PREP_NP ==> NP
                                                                 //       however, not having NP_LIST here makes parsing "from here and there.." impossible
     ;
@@ -465,270 +490,270 @@ PREP_NP:
 // TARGET (BE -- HAVE -- MODAL -- DO)
 
 BE_TARGET:
-      ADV_HAVE_TARGET       { $$ = MAKE_SYMBOL(ID_BE_TARGET, 1, $1); }     // quickly gone there
-    | GOING_MOD_INFIN INFIN { $$ = MAKE_SYMBOL(ID_BE_TARGET, 2, $1, $2); } // going to go there
-    | NP_LIST               { $$ = MAKE_SYMBOL(ID_BE_TARGET, 1, $1); }
-    | ADJ_LIST              { $$ = MAKE_SYMBOL(ID_BE_TARGET, 1, $1); }
-    | CMPWORD               { $$ = MAKE_SYMBOL(ID_BE_TARGET, 1, $1); }     // bigger
+      ADV_HAVE_TARGET       { $$ = MAKE_SYMBOL(ID_BE_TARGET, $1); }     // quickly gone there
+    | GOING_MOD_INFIN INFIN { $$ = MAKE_SYMBOL(ID_BE_TARGET, $1, $2); } // going to go there
+    | NP_LIST               { $$ = MAKE_SYMBOL(ID_BE_TARGET, $1); }
+    | ADJ_LIST              { $$ = MAKE_SYMBOL(ID_BE_TARGET, $1); }
+    | CMPWORD               { $$ = MAKE_SYMBOL(ID_BE_TARGET, $1); }     // bigger
     ;
 
 HAVE_TARGET:
-      VPASTPERF         { $$ = MAKE_SYMBOL(ID_HAVE_TARGET, 1, $1); }     // gone
-    | VPASTPERF NP_LIST { $$ = MAKE_SYMBOL(ID_HAVE_TARGET, 2, $1, $2); } // gone there
+      VPASTPERF         { $$ = MAKE_SYMBOL(ID_HAVE_TARGET, $1); }     // gone
+    | VPASTPERF NP_LIST { $$ = MAKE_SYMBOL(ID_HAVE_TARGET, $1, $2); } // gone there
     ;
 
 MODAL_TARGET:
-      DO_TARGET { $$ = MAKE_SYMBOL(ID_MODAL_TARGET, 1, $1); } // go there
-    | AUX_V     { $$ = MAKE_SYMBOL(ID_MODAL_TARGET, 1, $1); } // be there
+      DO_TARGET { $$ = MAKE_SYMBOL(ID_MODAL_TARGET, $1); } // go there
+    | AUX_V     { $$ = MAKE_SYMBOL(ID_MODAL_TARGET, $1); } // be there
     ;
 
 DO_TARGET:
-      ADV_V_NP { $$ = MAKE_SYMBOL(ID_DO_TARGET, 1, $1); } // quickly go there
-    | V_INFIN  { $$ = MAKE_SYMBOL(ID_DO_TARGET, 1, $1); } // like to go there
+      ADV_V_NP { $$ = MAKE_SYMBOL(ID_DO_TARGET, $1); } // quickly go there
+    | V_INFIN  { $$ = MAKE_SYMBOL(ID_DO_TARGET, $1); } // like to go there
     ;
 
 OPT_BE_TARGET:
-      /* empty */ { $$ = xl::node::SymbolNode::eol(); }
-    | BE_TARGET   { $$ = MAKE_SYMBOL(ID_OPT_BE_TARGET, 1, $1); } // there
+      /* empty */ { $$ = pc->tree_builder().eol(); }
+    | BE_TARGET   { $$ = MAKE_SYMBOL(ID_OPT_BE_TARGET, $1); } // there
     ;
 
 FREQ_DO_TARGET:
-           DO_TARGET { $$ = MAKE_SYMBOL(ID_FREQ_DO_TARGET, 1, $1); }     // quickly go there
-    | FREQ DO_TARGET { $$ = MAKE_SYMBOL(ID_FREQ_DO_TARGET, 2, $1, $2); } // always quickly go there
+           DO_TARGET { $$ = MAKE_SYMBOL(ID_FREQ_DO_TARGET, $1); }     // quickly go there
+    | FREQ DO_TARGET { $$ = MAKE_SYMBOL(ID_FREQ_DO_TARGET, $1, $2); } // always quickly go there
     ;
 
 //=============================================================================
 // VERB (ADVERB)
 
 ADV_V_NP:
-                V_NP           { $$ = MAKE_SYMBOL(ID_ADV_V_NP, 1, $1); }     // go there
-    | ADV_MOD_V V_NP           { $$ = MAKE_SYMBOL(ID_ADV_V_NP, 2, $1, $2); } // quickly go there
-    |           V_NP ADV_MOD_V { $$ = MAKE_SYMBOL(ID_ADV_V_NP, 2, $1, $2); } // go there quickly
+                V_NP           { $$ = MAKE_SYMBOL(ID_ADV_V_NP, $1); }     // go there
+    | ADV_MOD_V V_NP           { $$ = MAKE_SYMBOL(ID_ADV_V_NP, $1, $2); } // quickly go there
+    |           V_NP ADV_MOD_V { $$ = MAKE_SYMBOL(ID_ADV_V_NP, $1, $2); } // go there quickly
     ;
 
 ADV_VPAST_NP:
-                VPAST_NP           { $$ = MAKE_SYMBOL(ID_ADV_VPAST_NP, 1, $1); }     // went there
-    | ADV_MOD_V VPAST_NP           { $$ = MAKE_SYMBOL(ID_ADV_VPAST_NP, 2, $1, $2); } // quickly went there
-    |           VPAST_NP ADV_MOD_V { $$ = MAKE_SYMBOL(ID_ADV_VPAST_NP, 2, $1, $2); } // went there quickly
+                VPAST_NP           { $$ = MAKE_SYMBOL(ID_ADV_VPAST_NP, $1); }     // went there
+    | ADV_MOD_V VPAST_NP           { $$ = MAKE_SYMBOL(ID_ADV_VPAST_NP, $1, $2); } // quickly went there
+    |           VPAST_NP ADV_MOD_V { $$ = MAKE_SYMBOL(ID_ADV_VPAST_NP, $1, $2); } // went there quickly
     ;
 
 ADV_VGERUND_NP:
-                          VGERUND_NP                      { $$ = MAKE_SYMBOL(ID_ADV_VGERUND_NP, 1, $1); }     // going there
-    | ADV_MOD_VGERUND_PRE VGERUND_NP                      { $$ = MAKE_SYMBOL(ID_ADV_VGERUND_NP, 2, $1, $2); } // quickly going there
-    |                     VGERUND_NP ADV_MOD_VGERUND_POST { $$ = MAKE_SYMBOL(ID_ADV_VGERUND_NP, 2, $1, $2); } // going there quickly
+                          VGERUND_NP                      { $$ = MAKE_SYMBOL(ID_ADV_VGERUND_NP, $1); }     // going there
+    | ADV_MOD_VGERUND_PRE VGERUND_NP                      { $$ = MAKE_SYMBOL(ID_ADV_VGERUND_NP, $1, $2); } // quickly going there
+    |                     VGERUND_NP ADV_MOD_VGERUND_POST { $$ = MAKE_SYMBOL(ID_ADV_VGERUND_NP, $1, $2); } // going there quickly
     ;
 
 ADV_HAVE_TARGET:
-                HAVE_TARGET           { $$ = MAKE_SYMBOL(ID_ADV_HAVE_TARGET, 1, $1); }     // gone there
-    | ADV_MOD_V HAVE_TARGET           { $$ = MAKE_SYMBOL(ID_ADV_HAVE_TARGET, 2, $1, $2); } // quickly gone there
-    |           HAVE_TARGET ADV_MOD_V { $$ = MAKE_SYMBOL(ID_ADV_HAVE_TARGET, 2, $1, $2); } // gone there quickly
+                HAVE_TARGET           { $$ = MAKE_SYMBOL(ID_ADV_HAVE_TARGET, $1); }     // gone there
+    | ADV_MOD_V HAVE_TARGET           { $$ = MAKE_SYMBOL(ID_ADV_HAVE_TARGET, $1, $2); } // quickly gone there
+    |           HAVE_TARGET ADV_MOD_V { $$ = MAKE_SYMBOL(ID_ADV_HAVE_TARGET, $1, $2); } // gone there quickly
     ;
 
 //=============================================================================
 // INFINITIVE
 
 INFIN:
-      TO_NOT_OR_FREQ MODAL_TARGET { $$ = MAKE_SYMBOL(ID_INFIN, 2, $1, $2); } // to go there
+      TO_NOT_OR_FREQ MODAL_TARGET { $$ = MAKE_SYMBOL(ID_INFIN, $1, $2); } // to go there
     ;
 
 V_INFIN:
-      V_MOD_INFIN INFIN { $$ = MAKE_SYMBOL(ID_V_INFIN, 2, $1, $2); } // have to go there
+      V_MOD_INFIN INFIN { $$ = MAKE_SYMBOL(ID_V_INFIN, $1, $2); } // have to go there
     ;
 
 //=============================================================================
 // ADJECTIVE -- ADVERB
 
 ADJ_N:
-               N { $$ = MAKE_SYMBOL(ID_ADJ_N, 1, $1); }     // apple
-    | ADJ_LIST N { $$ = MAKE_SYMBOL(ID_ADJ_N, 2, $1, $2); } // red apple
+               N { $$ = MAKE_SYMBOL(ID_ADJ_N, $1); }     // apple
+    | ADJ_LIST N { $$ = MAKE_SYMBOL(ID_ADJ_N, $1, $2); } // red apple
     ;
 
 ADV_ADJ:
-                  ADJ { $$ = MAKE_SYMBOL(ID_ADV_ADJ, 1, $1); }     // red
-    | ADV_MOD_ADJ ADJ { $$ = MAKE_SYMBOL(ID_ADV_ADJ, 2, $1, $2); } // very red
+                  ADJ { $$ = MAKE_SYMBOL(ID_ADV_ADJ, $1); }     // red
+    | ADV_MOD_ADJ ADJ { $$ = MAKE_SYMBOL(ID_ADV_ADJ, $1, $2); } // very red
     ;
 
 //=============================================================================
 // DEMONSTRATIVE -- ARTICLE/PREFIX-POSSESSIVE
 
 DET_ADJ_N:
-      DEM                                 { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, 1, $1); }             // this
-    | DEM                           ADJ_N { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, 2, $1, $2); }         // this red apple
-    | NONE                                { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, 1, $1); }             // none
-    | EVERY                         ADJ_N { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, 2, $1, $2); }         // every red apple
-    | ART_OR_PREFIXPOSS             ADJ_N { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, 2, $1, $2); }         // the red apple
-    | ART_OR_PREFIXPOSS CMPWORD_EST       { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, 2, $1, $2); }         // the best
-    | ART_OR_PREFIXPOSS CMPWORD_EST     N { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, 3, $1, $2, $3); }     // the best thing
-    | ART_OR_PREFIXPOSS MOST ADJ          { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, 3, $1, $2, $3); }     // the most red
-    | ART_OR_PREFIXPOSS MOST ADJ        N { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, 4, $1, $2, $3, $4); } // the most red apple
+      DEM                                 { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, $1); }             // this
+    | DEM                           ADJ_N { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, $1, $2); }         // this red apple
+    | NONE                                { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, $1); }             // none
+    | EVERY                         ADJ_N { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, $1, $2); }         // every red apple
+    | ART_OR_PREFIXPOSS             ADJ_N { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, $1, $2); }         // the red apple
+    | ART_OR_PREFIXPOSS CMPWORD_EST       { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, $1, $2); }         // the best
+    | ART_OR_PREFIXPOSS CMPWORD_EST     N { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, $1, $2, $3); }     // the best thing
+    | ART_OR_PREFIXPOSS MOST ADJ          { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, $1, $2, $3); }     // the most red
+    | ART_OR_PREFIXPOSS MOST ADJ        N { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, $1, $2, $3, $4); } // the most red apple
     ;
 
 //=============================================================================
 // BE -- HAVE -- MODAL -- DO (NOT)
 
 BE_NOT:
-      BE     { $$ = MAKE_SYMBOL(ID_BE_NOT, 1, $1); }     // is
-    | BE NOT { $$ = MAKE_SYMBOL(ID_BE_NOT, 2, $1, $2); } // is not
+      BE     { $$ = MAKE_SYMBOL(ID_BE_NOT, $1); }     // is
+    | BE NOT { $$ = MAKE_SYMBOL(ID_BE_NOT, $1, $2); } // is not
     ;
 
 HAVE_NOT:
-      HAVE     { $$ = MAKE_SYMBOL(ID_HAVE_NOT, 1, $1); }     // have
-    | HAVE NOT { $$ = MAKE_SYMBOL(ID_HAVE_NOT, 2, $1, $2); } // have not
+      HAVE     { $$ = MAKE_SYMBOL(ID_HAVE_NOT, $1); }     // have
+    | HAVE NOT { $$ = MAKE_SYMBOL(ID_HAVE_NOT, $1, $2); } // have not
     ;
 
 MODAL_NOT:
-      MODAL     { $$ = MAKE_SYMBOL(ID_MODAL_NOT, 1, $1); }     // can
-    | MODAL NOT { $$ = MAKE_SYMBOL(ID_MODAL_NOT, 2, $1, $2); } // can not
+      MODAL     { $$ = MAKE_SYMBOL(ID_MODAL_NOT, $1); }     // can
+    | MODAL NOT { $$ = MAKE_SYMBOL(ID_MODAL_NOT, $1, $2); } // can not
     ;
 
 DO_NOT:
-      DO     { $$ = MAKE_SYMBOL(ID_DO_NOT, 1, $1); }     // do
-    | DO NOT { $$ = MAKE_SYMBOL(ID_DO_NOT, 2, $1, $2); } // do not
+      DO     { $$ = MAKE_SYMBOL(ID_DO_NOT, $1); }     // do
+    | DO NOT { $$ = MAKE_SYMBOL(ID_DO_NOT, $1, $2); } // do not
     ;
 
 //=============================================================================
 // BE -- HAVE -- MODAL -- DO (NOT NOUN FREQ)
 
 BE_NP:
-      BE_NOT NP_LIST      { $$ = MAKE_SYMBOL(ID_BE_NP, 2, $1, $2); }     // is he
-    | BE_NOT NP_LIST FREQ { $$ = MAKE_SYMBOL(ID_BE_NP, 3, $1, $2, $3); } // is he always
+      BE_NOT NP_LIST      { $$ = MAKE_SYMBOL(ID_BE_NP, $1, $2); }     // is he
+    | BE_NOT NP_LIST FREQ { $$ = MAKE_SYMBOL(ID_BE_NP, $1, $2, $3); } // is he always
     ;
 
 HAVE_NP:
-      HAVE_NOT NP_LIST      { $$ = MAKE_SYMBOL(ID_HAVE_NP, 2, $1, $2); }     // has he
-    | HAVE_NOT NP_LIST FREQ { $$ = MAKE_SYMBOL(ID_HAVE_NP, 3, $1, $2, $3); } // has he always
+      HAVE_NOT NP_LIST      { $$ = MAKE_SYMBOL(ID_HAVE_NP, $1, $2); }     // has he
+    | HAVE_NOT NP_LIST FREQ { $$ = MAKE_SYMBOL(ID_HAVE_NP, $1, $2, $3); } // has he always
     ;
 
 MODAL_NP:
-      MODAL_NOT NP_LIST      { $$ = MAKE_SYMBOL(ID_MODAL_NP, 2, $1, $2); }     // can he
-    | MODAL_NOT NP_LIST FREQ { $$ = MAKE_SYMBOL(ID_MODAL_NP, 3, $1, $2, $3); } // can he always
+      MODAL_NOT NP_LIST      { $$ = MAKE_SYMBOL(ID_MODAL_NP, $1, $2); }     // can he
+    | MODAL_NOT NP_LIST FREQ { $$ = MAKE_SYMBOL(ID_MODAL_NP, $1, $2, $3); } // can he always
     ;
 
 DO_NP:
-      DO_NOT NP_LIST      { $$ = MAKE_SYMBOL(ID_DO_NP, 2, $1, $2); }     // does he
-    | DO_NOT NP_LIST FREQ { $$ = MAKE_SYMBOL(ID_DO_NP, 3, $1, $2, $3); } // does he always
+      DO_NOT NP_LIST      { $$ = MAKE_SYMBOL(ID_DO_NP, $1, $2); }     // does he
+    | DO_NOT NP_LIST FREQ { $$ = MAKE_SYMBOL(ID_DO_NP, $1, $2, $3); } // does he always
     ;
 
 //=============================================================================
 // BE -- HAVE -- MODAL -- DO -- TO (NOT OR FREQ)
 
 BE_NOT_OR_FREQ:
-      BE             { $$ = MAKE_SYMBOL(ID_BE_NOT_OR_FREQ, 1, $1); }     // is
-    | BE NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_BE_NOT_OR_FREQ, 2, $1, $2); } // is not
+      BE             { $$ = MAKE_SYMBOL(ID_BE_NOT_OR_FREQ, $1); }     // is
+    | BE NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_BE_NOT_OR_FREQ, $1, $2); } // is not
     ;
 
 HAVE_NOT_OR_FREQ:
-      HAVE             { $$ = MAKE_SYMBOL(ID_HAVE_NOT_OR_FREQ, 1, $1); }     // have
-    | HAVE NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_HAVE_NOT_OR_FREQ, 2, $1, $2); } // have not
+      HAVE             { $$ = MAKE_SYMBOL(ID_HAVE_NOT_OR_FREQ, $1); }     // have
+    | HAVE NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_HAVE_NOT_OR_FREQ, $1, $2); } // have not
     ;
 
 MODAL_NOT_OR_FREQ:
-      MODAL             { $$ = MAKE_SYMBOL(ID_MODAL_NOT_OR_FREQ, 1, $1); }     // can
-    | MODAL NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_MODAL_NOT_OR_FREQ, 2, $1, $2); } // can not
+      MODAL             { $$ = MAKE_SYMBOL(ID_MODAL_NOT_OR_FREQ, $1); }     // can
+    | MODAL NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_MODAL_NOT_OR_FREQ, $1, $2); } // can not
     ;
 
 DO_NOT_OR_FREQ:
-      DO             { $$ = MAKE_SYMBOL(ID_DO_NOT_OR_FREQ, 1, $1); }     // do
-    | DO NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_DO_NOT_OR_FREQ, 2, $1, $2); } // do not
+      DO             { $$ = MAKE_SYMBOL(ID_DO_NOT_OR_FREQ, $1); }     // do
+    | DO NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_DO_NOT_OR_FREQ, $1, $2); } // do not
     ;
 
 TO_NOT_OR_FREQ:
-      TO_MOD_V             { $$ = MAKE_SYMBOL(ID_TO_NOT_OR_FREQ, 1, $1); }     // to
-    | TO_MOD_V NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_TO_NOT_OR_FREQ, 2, $1, $2); } // to not
+      TO_MOD_V             { $$ = MAKE_SYMBOL(ID_TO_NOT_OR_FREQ, $1); }     // to
+    | TO_MOD_V NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_TO_NOT_OR_FREQ, $1, $2); } // to not
     ;
 
 //=============================================================================
 // LIST
 
 S_LIST:
-             S_PUNC { $$ = MAKE_SYMBOL(ID_S_LIST, 1, $1); }
-    | S_LIST S_PUNC { $$ = MAKE_SYMBOL(ID_S_LIST, 2, $1, $2); }
+             S_PUNC { $$ = MAKE_SYMBOL(ID_S_LIST, $1); }
+    | S_LIST S_PUNC { $$ = APPEND_SYMBOL(ID_S_LIST, $1, $2); }
     ;
 
 CLAUSE_LIST:
-                              CLAUSE { $$ = MAKE_SYMBOL(ID_CLAUSE_LIST, 1, $1); }
-    | CLAUSE_LIST CONJ_CLAUSE CLAUSE { $$ = MAKE_SYMBOL(ID_CLAUSE_LIST, 3, $1, $2, $3); }
+                              CLAUSE { $$ = MAKE_SYMBOL(ID_CLAUSE_LIST, $1); }
+    | CLAUSE_LIST CONJ_CLAUSE CLAUSE { $$ = APPEND_SYMBOL(ID_CLAUSE_LIST, $1, $2, $3); }
     ;
 
 QCLAUSE_LIST:
-                               QCLAUSE { $$ = MAKE_SYMBOL(ID_QCLAUSE_LIST, 1, $1); }
-    | QCLAUSE_LIST CONJ_CLAUSE QCLAUSE { $$ = MAKE_SYMBOL(ID_QCLAUSE_LIST, 3, $1, $2, $3); }
+                               QCLAUSE { $$ = MAKE_SYMBOL(ID_QCLAUSE_LIST, $1); }
+    | QCLAUSE_LIST CONJ_CLAUSE QCLAUSE { $$ = APPEND_SYMBOL(ID_QCLAUSE_LIST, $1, $2, $3); }
     ;
 
 CVP_LIST:
-                           CVP { $$ = MAKE_SYMBOL(ID_CVP_LIST, 1, $1); }
-    | CVP_LIST CONJ_CLAUSE CVP { $$ = MAKE_SYMBOL(ID_CVP_LIST, 3, $1, $2, $3); }
+                           CVP { $$ = MAKE_SYMBOL(ID_CVP_LIST, $1); }
+    | CVP_LIST CONJ_CLAUSE CVP { $$ = APPEND_SYMBOL(ID_CVP_LIST, $1, $2, $3); }
     ;
 
 NP_LIST:
-                          NP { $$ = MAKE_SYMBOL(ID_NP_LIST, 1, $1); }
-    | NP_LIST CONJ_NP_NOT NP { $$ = MAKE_SYMBOL(ID_NP_LIST, 3, $1, $2, $3); }
+                          NP { $$ = MAKE_SYMBOL(ID_NP_LIST, $1); }
+    | NP_LIST CONJ_NP_NOT NP { $$ = APPEND_SYMBOL(ID_NP_LIST, $1, $2, $3); }
     ;
 
 VP_LIST:
-                          VP { $$ = MAKE_SYMBOL(ID_VP_LIST, 1, $1); }
-    | VP_LIST CONJ_VP_NOT VP { $$ = MAKE_SYMBOL(ID_VP_LIST, 3, $1, $2, $3); }
+                          VP { $$ = MAKE_SYMBOL(ID_VP_LIST, $1); }
+    | VP_LIST CONJ_VP_NOT VP { $$ = APPEND_SYMBOL(ID_VP_LIST, $1, $2, $3); }
     ;
 
 ADJ_LIST:
-                            ADV_ADJ { $$ = MAKE_SYMBOL(ID_ADJ_LIST, 1, $1); }
-    | ADJ_LIST              ADV_ADJ { $$ = MAKE_SYMBOL(ID_ADJ_LIST, 2, $1, $2); }
-    | ADJ_LIST CONJ_ADJ_NOT ADV_ADJ { $$ = MAKE_SYMBOL(ID_ADJ_LIST, 3, $1, $2, $3); }
+                            ADV_ADJ { $$ = MAKE_SYMBOL(ID_ADJ_LIST, $1); }
+    | ADJ_LIST              ADV_ADJ { $$ = APPEND_SYMBOL(ID_ADJ_LIST, $1, $2); }
+    | ADJ_LIST CONJ_ADJ_NOT ADV_ADJ { $$ = APPEND_SYMBOL(ID_ADJ_LIST, $1, $2, $3); }
     ;
 
 PREP_LIST:
-                              PREP_NP { $$ = MAKE_SYMBOL(ID_PREP_LIST, 1, $1); }
-    | PREP_LIST CONJ_PREP_NOT PREP_NP { $$ = MAKE_SYMBOL(ID_PREP_LIST, 3, $1, $2, $3); }
+                              PREP_NP { $$ = MAKE_SYMBOL(ID_PREP_LIST, $1); }
+    | PREP_LIST CONJ_PREP_NOT PREP_NP { $$ = APPEND_SYMBOL(ID_PREP_LIST, $1, $2, $3); }
     ;
 
 POSS_LIST:
-                           ADJ_N { $$ = MAKE_SYMBOL(ID_POSS_LIST, 1, $1); }
-    | POSS_LIST SUFFIXPOSS ADJ_N { $$ = MAKE_SYMBOL(ID_POSS_LIST, 3, $1, $2, $3); }
+                           ADJ_N { $$ = MAKE_SYMBOL(ID_POSS_LIST, $1); }
+    | POSS_LIST SUFFIXPOSS ADJ_N { $$ = APPEND_SYMBOL(ID_POSS_LIST, $1, $2, $3); }
     ;
 
 //=============================================================================
 // CONJUGATION
 
 CONJ_NP_NOT:
-      CONJ_NP             { $$ = MAKE_SYMBOL(ID_CONJ_NP_NOT, 1, $1); }     // and
-    | CONJ_NP NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_CONJ_NP_NOT, 2, $1, $2); } // and not
+      CONJ_NP             { $$ = MAKE_SYMBOL(ID_CONJ_NP_NOT, $1); }     // and
+    | CONJ_NP NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_CONJ_NP_NOT, $1, $2); } // and not
     ;
 
 CONJ_VP_NOT:
-      CONJ_VP             { $$ = MAKE_SYMBOL(ID_CONJ_VP_NOT, 1, $1); }     // and
-    | CONJ_VP NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_CONJ_VP_NOT, 2, $1, $2); } // and not
+      CONJ_VP             { $$ = MAKE_SYMBOL(ID_CONJ_VP_NOT, $1); }     // and
+    | CONJ_VP NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_CONJ_VP_NOT, $1, $2); } // and not
     ;
 
 CONJ_ADJ_NOT:
-      CONJ_ADJ             { $$ = MAKE_SYMBOL(ID_CONJ_ADJ_NOT, 1, $1); }     // and
-    | CONJ_ADJ NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_CONJ_ADJ_NOT, 2, $1, $2); } // and not
+      CONJ_ADJ             { $$ = MAKE_SYMBOL(ID_CONJ_ADJ_NOT, $1); }     // and
+    | CONJ_ADJ NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_CONJ_ADJ_NOT, $1, $2); } // and not
     ;
 
 CONJ_PREP_NOT:
-      CONJ_PREP             { $$ = MAKE_SYMBOL(ID_CONJ_PREP_NOT, 1, $1); }     // and
-    | CONJ_PREP NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_CONJ_PREP_NOT, 2, $1, $2); } // and not
+      CONJ_PREP             { $$ = MAKE_SYMBOL(ID_CONJ_PREP_NOT, $1); }     // and
+    | CONJ_PREP NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_CONJ_PREP_NOT, $1, $2); } // and not
     ;
 
 //=============================================================================
 // WH-PRONOUN
 
 WHPRON:
-      WHWORD          { $$ = MAKE_SYMBOL(ID_WHPRON, 1, $1); } // who (pronoun)
-    | WHWORD_MOD_THAT { $$ = MAKE_SYMBOL(ID_WHPRON, 1, $1); } // who (pronoun)
+      WHWORD          { $$ = MAKE_SYMBOL(ID_WHPRON, $1); } // who (pronoun)
+    | WHWORD_MOD_THAT { $$ = MAKE_SYMBOL(ID_WHPRON, $1); } // who (pronoun)
     ;
 
 //=============================================================================
  /* NOT-OR-FREQ -- EOS */
 
 NOT_OR_FREQ:
-      NOT      { $$ = MAKE_SYMBOL(ID_NOT_OR_FREQ, 1, $1); }     // not
-    | NOT FREQ { $$ = MAKE_SYMBOL(ID_NOT_OR_FREQ, 2, $1, $2); } // not always
-    |     FREQ { $$ = MAKE_SYMBOL(ID_NOT_OR_FREQ, 1, $1); }     // always
+      NOT      { $$ = MAKE_SYMBOL(ID_NOT_OR_FREQ, $1); }     // not
+    | NOT FREQ { $$ = MAKE_SYMBOL(ID_NOT_OR_FREQ, $1, $2); } // not always
+    |     FREQ { $$ = MAKE_SYMBOL(ID_NOT_OR_FREQ, $1); }     // always
     ;
 
 EOS:
-      TOO      { $$ = MAKE_SYMBOL(ID_EOS, 1, $1); } // too
-    | FREQ_EOS { $$ = MAKE_SYMBOL(ID_EOS, 1, $1); } // always
+      TOO      { $$ = MAKE_SYMBOL(ID_EOS, $1); } // too
+    | FREQ_EOS { $$ = MAKE_SYMBOL(ID_EOS, $1); } // always
     ;
 
 //=========
@@ -959,7 +984,8 @@ PUNC:
 ScannerContext::ScannerContext(const char* buf)
     : m_scanner(NULL), m_buf(buf), m_pos(0), m_length(strlen(buf)),
       m_line(1), m_column(1), m_prev_column(1), m_word_index(0),
-      m_pos_lexer_id_path(NULL)
+      m_pos_lexer_id_path(NULL),
+      m_cancel(NULL)
 {}
 
 uint32_t ScannerContext::current_lexer_id()
@@ -971,34 +997,142 @@ uint32_t ScannerContext::current_lexer_id()
     return (*m_pos_lexer_id_path)[m_word_index];
 }
 
+// owns a reentrant scanner, so every exit path (including exceptions other
+// than the parser's own const char* errors) destroys it
+struct scanner_guard_t
+{
+    yyscan_t m_scanner;
+
+    scanner_guard_t(ParserContext* parser_context) : m_scanner(parser_context->scanner_context().m_scanner) {
+        yylex_init(&m_scanner);
+        yyset_extra(parser_context, m_scanner);
+    }
+    ~scanner_guard_t() {
+        yylex_destroy(m_scanner);
+    }
+
+private:
+    scanner_guard_t(const scanner_guard_t &);
+    scanner_guard_t &operator=(const scanner_guard_t &);
+};
+
 uint32_t quick_lex(const char* s)
 {
     xl::Allocator alloc(__FILE__);
     ParserContext parser_context(alloc, s);
-    yyscan_t scanner = parser_context.scanner_context().m_scanner;
-    yylex_init(&scanner);
-    yyset_extra(&parser_context, scanner);
+    scanner_guard_t scanner_guard(&parser_context);
     YYSTYPE dummy_sa;
     YYLTYPE dummy_loc;
-    uint32_t lexer_id = yylex(&dummy_sa, &dummy_loc, scanner); // scanner entry point
-    yylex_destroy(scanner);
-    return lexer_id;
+    return yylex(&dummy_sa, &dummy_loc, scanner_guard.m_scanner); // scanner entry point
 }
 
-xl::node::NodeIdentIFace* make_ast(xl::Allocator         &alloc,
-                                   const char*            s,
-                                   std::vector<uint32_t> &pos_lexer_id_path,
-                                   std::stringstream     &error_messages)
+ast_ref_t TreeBuilder::make_symbol(uint32_t lexer_id, const std::vector<ast_ref_t> &children)
 {
-    ParserContext parser_context(alloc, s);
+    if(m_flat_tree) {
+        std::vector<xl::node::FlatTree::index_t> index_vec;
+        for(std::vector<ast_ref_t>::const_iterator p = children.begin(); p != children.end(); p++) {
+            index_vec.push_back((*p).m_index);
+        }
+        return ref(m_flat_tree->make_symbol(lexer_id, index_vec));
+    }
+    std::vector<xl::node::NodeIdentIFace*> node_vec;
+    for(std::vector<ast_ref_t>::const_iterator p = children.begin(); p != children.end(); p++) {
+        node_vec.push_back((*p).m_node);
+    }
+    return ref(xl::mvc::MVCModel::make_symbol(m_tc, lexer_id, node_vec));
+}
+
+ast_ref_t TreeBuilder::copy(const xl::node::NodeIdentIFace* _node)
+{
+    if(m_flat_tree) {
+        return ref(m_flat_tree->import(_node));
+    }
+    return ref(_node ? _node->clone(m_tc) : NULL);
+}
+
+void TreeBuilder::set_root(ast_ref_t root)
+{
+    if(m_flat_tree) {
+        m_flat_tree->root() = root.m_index;
+        return;
+    }
+    m_tc->root() = root.m_node;
+}
+
+xl::node::NodeIdentIFace* TreeBuilder::finish()
+{
+    if(!m_flat_tree) {
+        return m_tc->root();
+    }
+    m_flat_tree->compact(); // drop what left-recursive list rules stranded
+    xl::node::FlatTreeView* flat_view = new (PNEW(m_tc->alloc(), xl::node::, FlatTreeView))
+            xl::node::FlatTreeView(*m_flat_tree);
+    return flat_view->root();
+}
+
+xl::node::FlatTree* new_flat_tree(xl::Allocator &alloc)
+{
+    xl::node::FlatTree* flat_tree = new (PNEW(alloc, xl::node::, FlatTree)) xl::node::FlatTree;
+    flat_tree->set_budget(alloc.budget());
+    return flat_tree;
+}
+
+xl::node::NodeIdentIFace* make_ast(xl::Allocator           &alloc,
+                                   const char*              s,
+                                   std::vector<uint32_t>   &pos_lexer_id_path,
+                                   std::stringstream       &error_messages,
+                                   const std::atomic<bool>* cancel,
+                                   xl::node::FlatTree*      flat_tree)
+{
+    ParserContext parser_context(alloc, s, flat_tree);
     parser_context.scanner_context().m_pos_lexer_id_path = &pos_lexer_id_path;
-    yyscan_t scanner = parser_context.scanner_context().m_scanner;
-    yylex_init(&scanner);
-    yyset_extra(&parser_context, scanner);
-    int error_code = yyparse(&parser_context, scanner); // parser entry point
-    yylex_destroy(scanner);
+    parser_context.scanner_context().m_cancel            = cancel;
+    int error_code = 0;
+    {
+        scanner_guard_t scanner_guard(&parser_context);
+        error_code = yyparse(&parser_context, scanner_guard.m_scanner); // parser entry point
+    }
     error_messages << parser_context.m_error_messages.str();
-    return (!error_code && parser_context.m_error_messages.str().empty()) ? parser_context.tree_context().root() : NULL;
+    return (!error_code && parser_context.m_error_messages.str().empty()) ? parser_context.tree_builder().finish() : NULL;
+}
+
+// Runs the parser's own LR tables over one token, with no semantic actions,
+// so a parse can be forked by copying its state stack. Returns false where
+// the parser would report a syntax error; lexer id 0 (end of input) returns
+// true only if the input is accepted.
+bool lr_advance(std::vector<int>* state_stack, uint32_t lexer_id)
+{
+    if(state_stack->empty()) {
+        state_stack->push_back(0);
+    }
+    int token = YYTRANSLATE(lexer_id);
+    while(true) {
+        int state = state_stack->back();
+        int rule = 0;
+        int n = yypact[state];
+        if(!yypact_value_is_default(n) && 0 <= n + token && n + token <= YYLAST && yycheck[n + token] == token) {
+            n = yytable[n + token];
+            if(n > 0) {
+                state_stack->push_back(n);
+                return lexer_id || n == YYFINAL;
+            }
+            if(yytable_value_is_error(n)) {
+                return false;
+            }
+            rule = -n;
+        } else {
+            rule = yydefact[state];
+            if(!rule) {
+                return false;
+            }
+        }
+        state_stack->resize(state_stack->size() - yyr2[rule]);
+        int lhs = yyr1[rule] - YYNTOKENS;
+        int top = state_stack->back();
+        int goto_index = yypgoto[lhs] + top;
+        state_stack->push_back((0 <= goto_index && goto_index <= YYLAST && yycheck[goto_index] == top) ?
+                yytable[goto_index] : yydefgoto[lhs]);
+    }
 }
 
 void display_usage(bool verbose)
@@ -1009,6 +1143,10 @@ void display_usage(bool verbose)
                   << std::endl
                   << "Input control:" << std::endl
                   << "  -e, --expr EXPRESSION" << std::endl
+                  << "      --corpus=CORPUS_FILE (one sentence per line, - for stdin)" << std::endl
+                  << "      --fifo (parse a corpus in input order, not cheapest first)" << std::endl
+                  << "      --mode=thread|process (default: thread)" << std::endl
+                  << "      --workers=WORKER_COUNT (with --mode=process, default: one per CPU)" << std::endl
                   << std::endl
                   << "Output control:" << std::endl
                   << "  -l, --lisp" << std::endl
@@ -1017,6 +1155,20 @@ void display_usage(bool verbose)
                   << "  -x, --extract" << std::endl
                   << "  -q, --quiet" << std::endl
                   << "  -m, --memory" << std::endl
+                  << "  -f, --flat" << std::endl
+                  << "  -c, --cons" << std::endl
+                  << "  -u, --unique" << std::endl
+                  << "  -r, --rules" << std::endl
+                  << "  -p, --max-paths=MAX_PATH_COUNT (default: 65536, 0 for no limit)" << std::endl
+                  << "      --sample=SAMPLE_COUNT" << std::endl
+                  << "      --seed=SEED (default: 0)" << std::endl
+                  << "      --stats=STATS_FILE" << std::endl
+                  << "      --beam=BEAM_WIDTH" << std::endl
+                  << "      --path-range=START:END (POS-paths START up to but not including END, END empty for the rest)" << std::endl
+                  << "      --stream (read words from stdin)" << std::endl
+                  << "      --deadline-ms=DEADLINE_MS" << std::endl
+                  << "      --mem-budget=SENTENCE_BYTES" << std::endl
+                  << "      --process-mem-budget=PROCESS_BYTES" << std::endl
                   << "  -h, --help" << std::endl
                   << std::endl
                   << "Example:" << std::endl
@@ -1044,13 +1196,51 @@ struct options_t
     bool        quiet;
     bool        indent;
     bool        serial;
+    bool        flat;
+    bool        hash_cons;
+    bool        unique;
+    bool        pos_rules;
+    size_t      max_path_count;
+    size_t      sample_count;
+    uint64_t    seed;
+    std::string stats_filename;
+    size_t      beam_width;
+    bool        stream;
+    size_t      deadline_ms;
+    size_t      mem_budget;
+    size_t      process_mem_budget;
+    std::string corpus_filename;
+    bool        fifo;
+    size_t      worker_count;
+    bool        process_mode;
+    bool        path_range;
+    uint64_t    path_range_start;
+    uint64_t    path_range_end;
 
     options_t()
         : mode(MODE_NONE),
           dump_memory(false),
           quiet(false),
           indent(false),
-          serial(false)
+          serial(false),
+          flat(false),
+          hash_cons(false),
+          unique(false),
+          pos_rules(false),
+          max_path_count(MAX_PATH_COUNT),
+          sample_count(0),
+          seed(0),
+          beam_width(0),
+          stream(false),
+          deadline_ms(0),
+          mem_budget(0),
+          process_mem_budget(0),
+          fifo(false),
+          worker_count(0),
+          process_mode(false),
+          path_range(false),
+          path_range_start(0),
+          path_range_end(0)
     {}
 };
 
@@ -1061,7 +1251,22 @@ bool extract_options_from_args(options_t* options, int argc, char** argv)
     }
     int opt = 0;
     int longIndex = 0;
-    static const char *optString = "e:lgdxqmnsh?";
+    enum {
+        OPT_SAMPLE = 256, // long-only options
+        OPT_SEED,
+        OPT_STATS,
+        OPT_BEAM,
+        OPT_STREAM,
+        OPT_DEADLINE_MS,
+        OPT_MEM_BUDGET,
+        OPT_PROCESS_MEM_BUDGET,
+        OPT_CORPUS,
+        OPT_FIFO,
+        OPT_WORKERS,
+        OPT_MODE,
+        OPT_PATH_RANGE
+    };
+    static const char *optString = "e:lgdxqmnsfcurp:h?";
     static const struct option longOpts[] = { { "expr",    required_argument, NULL, 'e' },
                                               { "lisp",    no_argument,       NULL, 'l' },
                                               { "graph",   no_argument,       NULL, 'g' },
@@ -1071,6 +1276,24 @@ bool extract_options_from_args(options_t* options, int argc, char** argv)
                                               { "memory",  no_argument,       NULL, 'm' },
                                               { "indent",  no_argument,       NULL, 'n' },
                                               { "serial",  no_argument,       NULL, 's' },
+                                              { "flat",    no_argument,       NULL, 'f' },
+                                              { "cons",    no_argument,       NULL, 'c' },
+                                              { "unique",  no_argument,       NULL, 'u' },
+                                              { "rules",   no_argument,       NULL, 'r' },
+                                              { "max-paths", required_argument, NULL, 'p' },
+                                              { "sample",  required_argument, NULL, OPT_SAMPLE },
+                                              { "seed",    required_argument, NULL, OPT_SEED },
+                                              { "stats",   required_argument, NULL, OPT_STATS },
+                                              { "beam",    required_argument, NULL, OPT_BEAM },
+                                              { "stream",  no_argument,       NULL, OPT_STREAM },
+                                              { "deadline-ms", required_argument, NULL, OPT_DEADLINE_MS },
+                                              { "mem-budget", required_argument, NULL, OPT_MEM_BUDGET },
+                                              { "process-mem-budget", required_argument, NULL, OPT_PROCESS_MEM_BUDGET },
+                                              { "corpus",  required_argument, NULL, OPT_CORPUS },
+                                              { "fifo",    no_argument,       NULL, OPT_FIFO },
+                                              { "workers", required_argument, NULL, OPT_WORKERS },
+                                              { "mode",    required_argument, NULL, OPT_MODE },
+                                              { "path-range", required_argument, NULL, OPT_PATH_RANGE },
                                               { "help",    no_argument,       NULL, 'h' },
                                               { NULL,      no_argument,       NULL, 0   } };
     opt = getopt_long(argc, argv, optString, longOpts, &longIndex);
@@ -1085,6 +1308,44 @@ bool extract_options_from_args(options_t* options, int argc, char** argv)
             case 'm': options->dump_memory = true; break;
             case 'n': options->indent = true; break;
             case 's': options->serial = true; break;
+            case 'f': options->flat = true; break;
+            case 'c': options->hash_cons = true; break;
+            case 'u': options->unique = true; break;
+            case 'r': options->pos_rules = true; break;
+            case 'p': options->max_path_count = atoi(optarg); break;
+            case OPT_SAMPLE: options->sample_count = atoi(optarg); break;
+            case OPT_SEED: options->seed = strtoull(optarg, NULL, 10); break;
+            case OPT_STATS: options->stats_filename = optarg; break;
+            case OPT_BEAM: options->beam_width = atoi(optarg); break;
+            case OPT_STREAM: options->stream = true; break;
+            case OPT_DEADLINE_MS: options->deadline_ms = atoi(optarg); break;
+            case OPT_MEM_BUDGET: options->mem_budget = strtoull(optarg, NULL, 10); break;
+            case OPT_PROCESS_MEM_BUDGET: options->process_mem_budget = strtoull(optarg, NULL, 10); break;
+            case OPT_CORPUS: options->corpus_filename = optarg; break;
+            case OPT_FIFO: options->fifo = true; break;
+            case OPT_WORKERS: options->worker_count = atoi(optarg); break;
+            case OPT_MODE:
+                if(!strcmp(optarg, "process")) {
+                    options->process_mode = true;
+                } else if(!strcmp(optarg, "thread")) {
+                    options->process_mode = false;
+                } else {
+                    options->mode = options_t::MODE_HELP;
+                }
+                break;
+            case OPT_PATH_RANGE:
+                {
+                    char* colon = NULL;
+                    options->path_range_start = strtoull(optarg, &colon, 10);
+                    if(*colon != ':') {
+                        options->mode = options_t::MODE_HELP;
+                        break;
+                    }
+                    options->path_range_end = *(colon + 1) ? strtoull(colon + 1, NULL, 10) :
+                                                             std::numeric_limits<uint64_t>::max();
+                    options->path_range = true;
+                }
+                break;
             case 'h':
             case '?': options->mode = options_t::MODE_HELP; break;
             case 0: // reserved
@@ -1100,12 +1361,12 @@ struct pos_path_ast_tuple_t
 {
     std::vector<std::string>  m_pos_path;
     xl::node::NodeIdentIFace* m_ast;
-    int                       m_path_index;
+    uint64_t                  m_path_index;
 
     pos_path_ast_tuple_t(
             std::vector<std::string>  &pos_path,
             xl::node::NodeIdentIFace*  ast,
-            int                        path_index)
+            uint64_t                   path_index)
         : m_pos_path(pos_path),
           m_ast(ast),
           m_path_index(path_index) {}
@@ -1117,6 +1378,15 @@ struct job_context_t
     pos_path_ast_tuple_t m_pos_path_ast_tuple;
     std::stringstream*   m_shared_header;
     std::stringstream*   m_shared_footer;
+    xl::ConsContext*     m_cons_context;
+    const std::atomic<bool>* m_cancel;
+    bool                 m_dispatched;
+    bool                 m_completed; // parse ran to a verdict, not stopped by deadline or budget
+    bool                 m_cancelled;
+    bool                 m_over_budget;
+    job_context_t*       m_skeleton_of; // parsed job with the same lexer-id path
+    job_context_t*       m_duplicate_of;
+    std::vector<uint64_t> m_duplicate_path_indices;
     xl::Allocator        m_alloc;
     std::stringstream    m_output;
     std::stringstream    m_info_messages;
@@ -1125,12 +1395,26 @@ struct job_context_t
     job_context_t(options_t*           options,
                   pos_path_ast_tuple_t pos_path_ast_tuple,
                   std::stringstream*   shared_header = NULL,
-                  std::stringstream*   shared_footer = NULL)
+                  std::stringstream*   shared_footer = NULL,
+                  xl::ConsContext*     cons_context  = NULL,
+                  const std::atomic<bool>* cancel    = NULL,
+                  xl::MemBudget*       mem_budget    = NULL)
         : m_options(options),
           m_pos_path_ast_tuple(pos_path_ast_tuple),
           m_shared_header(shared_header),
           m_shared_footer(shared_footer),
-          m_alloc(__FILE__) {}
+          m_cons_context(cons_context),
+          m_cancel(cancel),
+          m_dispatched(false),
+          m_completed(false),
+          m_cancelled(false),
+          m_over_budget(false),
+          m_skeleton_of(NULL),
+          m_duplicate_of(NULL),
+          m_alloc(__FILE__)
+    {
+        m_alloc.set_budget(mem_budget);
+    }
 };
 
 bool filter_node(const xl::node::NodeIdentIFace* node)
@@ -1140,16 +1424,25 @@ bool filter_node(const xl::node::NodeIdentIFace* node)
         return true;
     }
     if(node->type() == xl::node::NodeIdentIFace::IDENT) {
-        std::cout << *dynamic_cast<const xl::node::TermNodeIFace<xl::node::NodeIdentIFace::IDENT>*>(node)->value() << std::endl;
+        std::cout << *xl::node::term_cast<xl::node::NodeIdentIFace::IDENT>(node)->value() << std::endl;
     }
     return true;
 }
 
-bool import_ast(options_t             &options,
-                xl::Allocator         &alloc,
-                pos_path_ast_tuple_t*  pos_path_ast_tuple,
-                std::stringstream     &info_messages,
-                std::stringstream     &error_messages)
+static void dump_flat_tree(const pos_path_ast_tuple_t* pos_path_ast_tuple,
+                           const xl::node::FlatTree*   flat_tree,
+                           std::stringstream          &info_messages)
+{
+    info_messages << "INFO: Flat AST for path #" << pos_path_ast_tuple->m_path_index << ": "
+                  << flat_tree->size() << " nodes, " << flat_tree->size_bytes() << " bytes" << std::endl;
+}
+
+bool import_ast(options_t               &options,
+                xl::Allocator           &alloc,
+                pos_path_ast_tuple_t*    pos_path_ast_tuple,
+                std::stringstream       &info_messages,
+                std::stringstream       &error_messages,
+                const std::atomic<bool>* cancel = NULL)
 {
     if(!pos_path_ast_tuple) {
         return false;
@@ -1164,9 +1457,11 @@ bool import_ast(options_t             &options,
     for(std::vector<std::string>::const_iterator p = pos_path.begin(); p != pos_path.end(); p++) {
         pos_lexer_id_path.push_back(name_to_id(*p));
     }
+    xl::node::FlatTree* flat_tree = options.flat ? new_flat_tree(alloc) : NULL;
 #if 1
     // NOTE: doesn't depend on SCANNER_CONTEXT.current_lexer_id()
-    xl::node::NodeIdentIFace* ast = make_ast(alloc, pos_path_str.c_str(), pos_lexer_id_path, error_messages);
+    xl::node::NodeIdentIFace* ast = make_ast(alloc, pos_path_str.c_str(), pos_lexer_id_path, error_messages, cancel,
+                                             flat_tree);
 #else
     // NOTE: depends on SCANNER_CONTEXT.current_lexer_id()
     xl::node::NodeIdentIFace* ast = make_ast(alloc, options.expr.c_str(), pos_lexer_id_path, error_messages);
@@ -1177,10 +1472,108 @@ bool import_ast(options_t             &options,
         return false;
     }
     pos_path_ast_tuple->m_ast = ast;
+    if(flat_tree && options.dump_memory) {
+        dump_flat_tree(pos_path_ast_tuple, flat_tree, info_messages);
+    }
     info_messages << "INFO: Successfully imported path #" << pos_path_ast_tuple->m_path_index << std::endl;
     return true;
 }
 
+// the ident a lexer rule makes of a POS-path element "{word}TAG"
+static std::string pos_to_leaf_name(const std::string &pos)
+{
+    size_t n = pos.find('}');
+    if(n == std::string::npos) {
+        return pos;
+    }
+    std::string word = pos.substr(1, n - 1);
+    std::string tag  = pos.substr(n + 1);
+    return (word == tag) ? std::string("{") + word + "}" : pos;
+}
+
+// copies skeleton, renaming its ident leaves from one POS-path to another in token order
+bool relabel_ast(TreeBuilder*                     builder,
+                 const xl::node::NodeIdentIFace*  skeleton,
+                 const std::vector<std::string>  &from_pos_path,
+                 const std::vector<std::string>  &to_pos_path,
+                 size_t*                          pos_index,
+                 ast_ref_t*                       copy)
+{
+    if(!skeleton) {
+        *copy = builder->null();
+        return true;
+    }
+    switch(skeleton->type()) {
+        case xl::node::NodeIdentIFace::IDENT:
+            {
+                const std::string &leaf_name = *xl::node::term_cast<xl::node::NodeIdentIFace::IDENT>(skeleton)->value();
+                while(*pos_index < from_pos_path.size() && pos_to_leaf_name(from_pos_path[*pos_index]) != leaf_name) {
+                    (*pos_index)++; // token that left no leaf
+                }
+                if(*pos_index == from_pos_path.size()) {
+                    return false;
+                }
+                *copy = builder->make_term(skeleton->lexer_id(),
+                        builder->tree_context().alloc_unique_string(pos_to_leaf_name(to_pos_path[*pos_index])));
+                (*pos_index)++;
+                return true;
+            }
+        case xl::node::NodeIdentIFace::SYMBOL:
+            {
+                const xl::node::SymbolNodeIFace* symbol = xl::node::symbol_cast(skeleton);
+                std::vector<ast_ref_t> child_copies;
+                for(size_t i = 0; i < symbol->size(); i++) {
+                    ast_ref_t child_copy;
+                    if(!relabel_ast(builder, (*symbol)[i], from_pos_path, to_pos_path, pos_index, &child_copy)) {
+                        return false;
+                    }
+                    child_copies.push_back(child_copy);
+                }
+                *copy = builder->make_symbol(skeleton->lexer_id(), child_copies); // no same-type children to flatten
+                return true;
+            }
+        default:
+            *copy = builder->copy(skeleton);
+            return true;
+    }
+}
+
+// the parser only sees lexer ids, so a path sharing them with an already
+// parsed path gets that path's AST with its own leaves instead of a parse
+bool instantiate_ast(options_t               &options,
+                     xl::Allocator           &alloc,
+                     pos_path_ast_tuple_t*    pos_path_ast_tuple,
+                     pos_path_ast_tuple_t*    skeleton_tuple,
+                     std::stringstream       &info_messages,
+                     std::stringstream       &error_messages,
+                     const std::atomic<bool>* cancel = NULL)
+{
+    if(!skeleton_tuple->m_ast) {
+        pos_path_ast_tuple->m_ast = NULL;
+        error_messages << "ERROR: Failed to import path #" << pos_path_ast_tuple->m_path_index
+                       << " (same lexer ids as path #" << skeleton_tuple->m_path_index << ")" << std::endl;
+        return false;
+    }
+    xl::TreeContext tc(alloc);
+    xl::node::FlatTree* flat_tree = options.flat ? new_flat_tree(alloc) : NULL;
+    TreeBuilder builder(&tc, flat_tree);
+    size_t pos_index = 0;
+    ast_ref_t ast;
+    if(!relabel_ast(&builder, skeleton_tuple->m_ast, skeleton_tuple->m_pos_path,
+                                                     pos_path_ast_tuple->m_pos_path, &pos_index, &ast))
+    {
+        return import_ast(options, alloc, pos_path_ast_tuple, info_messages, error_messages, cancel);
+    }
+    builder.set_root(ast);
+    pos_path_ast_tuple->m_ast = builder.finish();
+    if(flat_tree && options.dump_memory) {
+        dump_flat_tree(pos_path_ast_tuple, flat_tree, info_messages);
+    }
+    info_messages << "INFO: Successfully instantiated path #" << pos_path_ast_tuple->m_path_index
+                  << " from path #" << skeleton_tuple->m_path_index << std::endl;
+    return true;
+}
+
 bool export_ast(options_t            &options,
                 pos_path_ast_tuple_t &pos_path_ast_tuple,
                 std::stringstream    &output,
@@ -1198,7 +1591,7 @@ bool export_ast(options_t            &options,
     info_messages << "INFO: Exporting path #" << pos_path_ast_tuple.m_path_index << ": " << pos_path_str << std::endl;
     switch(options.mode) {
         case options_t::MODE_LISP:  output << xl::mvc::MVCView::print_lisp(ast, options.indent); break;
-        case options_t::MODE_GRAPH: output << xl::mvc::MVCView::print_graph(ast); break;
+        case options_t::MODE_GRAPH: output << xl::mvc::MVCView::print_graph(ast, pos_path_ast_tuple.m_path_index); break;
         case options_t::MODE_DOT:   output << xl::mvc::MVCView::print_dot(ast, false, false); break;
         case options_t::MODE_EXTRACT:
             {
@@ -1221,48 +1614,100 @@ bool export_ast(options_t            &options,
     return true;
 }
 
+// rendering is reentrant; only the header and footer jobs share need the lock
+void export_job(job_context_t* job)
+{
+    if(job->m_options->mode == options_t::MODE_DOT) {
+        pthread_mutex_lock(&graph_mutex);
+        if(job->m_shared_header && (*job->m_shared_header).str().empty()) {
+            *job->m_shared_header << xl::mvc::MVCView::print_dot_header(false);
+        }
+        pthread_mutex_unlock(&graph_mutex);
+        export_ast(*job->m_options, job->m_pos_path_ast_tuple,
+                                    job->m_output,
+                                    job->m_info_messages);
+        pthread_mutex_lock(&graph_mutex);
+        if(job->m_shared_footer && (*job->m_shared_footer).str().empty()) {
+            *job->m_shared_footer << xl::mvc::MVCView::print_dot_footer();
+        }
+        pthread_mutex_unlock(&graph_mutex);
+    } else {
+        export_ast(*job->m_options, job->m_pos_path_ast_tuple,
+                                    job->m_output,
+                                    job->m_info_messages);
+    }
+}
+
 void* do_job(void* args)
 {
     job_context_t* job = reinterpret_cast<job_context_t*>(args);
+    job->m_dispatched = true;
+    bool dump_memory = job->m_options->dump_memory;
     do {
         try {
-            if(!import_ast(*job->m_options, job->m_alloc, &job->m_pos_path_ast_tuple,
-                                                           job->m_info_messages,
-                                                           job->m_error_messages))
+            if(job->m_skeleton_of) {
+                if(!instantiate_ast(*job->m_options, job->m_alloc, &job->m_pos_path_ast_tuple,
+                                                                   &job->m_skeleton_of->m_pos_path_ast_tuple,
+                                                                    job->m_info_messages,
+                                                                    job->m_error_messages,
+                                                                    job->m_cancel))
+                {
+                    job->m_completed = true;
+                    break;
+                }
+            } else if(!import_ast(*job->m_options, job->m_alloc, &job->m_pos_path_ast_tuple,
+                                                                  job->m_info_messages,
+                                                                  job->m_error_messages,
+                                                                  job->m_cancel))
             {
+                job->m_completed = true;
                 break;
             }
         } catch(const char* s) {
             job->m_error_messages << "ERROR: " << s << std::endl;
+            job->m_cancelled   = !strcmp(s, ERROR_DEADLINE_EXCEEDED);
+            job->m_over_budget = !strcmp(s, ERROR_MEM_BUDGET_EXCEEDED);
+            job->m_completed   = !job->m_cancelled && !job->m_over_budget;
             break;
         }
-        pthread_mutex_lock(&graph_mutex);
-        if(job->m_options->mode == options_t::MODE_DOT) {
-            if(job->m_shared_header && (*job->m_shared_header).str().empty()) {
-                *job->m_shared_header << xl::mvc::MVCView::print_dot_header(false);
+        job->m_completed = true;
+        if(job->m_cons_context) {
+            pthread_mutex_lock(&cons_mutex);
+            try {
+                job->m_pos_path_ast_tuple.m_ast = job->m_cons_context->intern(job->m_pos_path_ast_tuple.m_ast);
+            } catch(const char* s) {
+                pthread_mutex_unlock(&cons_mutex);
+                job->m_pos_path_ast_tuple.m_ast = NULL;
+                job->m_error_messages << "ERROR: " << s << std::endl;
+                job->m_over_budget = !strcmp(s, ERROR_MEM_BUDGET_EXCEEDED);
+                job->m_completed   = !job->m_over_budget;
+                break;
             }
-            export_ast(*job->m_options, job->m_pos_path_ast_tuple,
-                                        job->m_output,
-                                        job->m_info_messages);
-            if(job->m_shared_footer && (*job->m_shared_footer).str().empty()) {
-                *job->m_shared_footer << xl::mvc::MVCView::print_dot_footer();
+            pthread_mutex_unlock(&cons_mutex);
+            if(dump_memory) {
+                job->m_info_messages << job->m_alloc.dump(std::string(1, '\t'));
+                dump_memory = false;
             }
-        } else {
-            export_ast(*job->m_options, job->m_pos_path_ast_tuple,
-                                        job->m_output,
-                                        job->m_info_messages);
+            job->m_alloc._free(); // only the interned copy is used from here on
         }
-        pthread_mutex_unlock(&graph_mutex);
+        if(job->m_options->unique) {
+            break; // exported once all jobs are in, see dedupe_jobs
+        }
+        export_job(job);
     } while(0);
-    if(job->m_options->dump_memory) {
+    if(dump_memory) {
         job->m_info_messages << job->m_alloc.dump(std::string(1, '\t'));
     }
+    if(!job->m_pos_path_ast_tuple.m_ast) {
+        job->m_alloc._free(); // give a failed parse's budget back to the others
+    }
     return NULL;
 }
 
 void process_batch_jobs(std::vector<job_context_t*>& batch_jobs)
 {
     pthread_mutex_init(&graph_mutex, NULL);
+    pthread_mutex_init(&cons_mutex, NULL);
     for(int i = 0; i < static_cast<int>(batch_jobs.size()); ++i) {
         if(pthread_create(&threads[i], NULL, do_job, batch_jobs[i]) != 0) {
             fprintf(stderr, "ERROR: Failed to create thread: %d\n", i);
@@ -1275,21 +1720,288 @@ void process_batch_jobs(std::vector<job_context_t*>& batch_jobs)
         }
     }
     pthread_mutex_destroy(&graph_mutex);
+    pthread_mutex_destroy(&cons_mutex);
 }
 
-bool apply_options(options_t &options)
+// groups jobs whose ASTs are structurally identical; returns the group count
+int dedupe_jobs(std::vector<job_context_t> &all_jobs)
 {
-    if(options.mode == options_t::MODE_HELP) {
-        display_usage(true);
-        return true;
+    std::map<uint64_t, std::vector<job_context_t*>> hash_to_jobs;
+    int unique_count = 0;
+    for(std::vector<job_context_t>::iterator p = all_jobs.begin(); p != all_jobs.end(); p++) {
+        xl::node::NodeIdentIFace* ast = (*p).m_pos_path_ast_tuple.m_ast;
+        if(!ast) {
+            continue;
+        }
+        std::vector<job_context_t*> &bucket = hash_to_jobs[ast->hash()];
+        for(std::vector<job_context_t*>::iterator q = bucket.begin(); q != bucket.end(); q++) {
+            if((*q)->m_pos_path_ast_tuple.m_ast->compare(ast)) {
+                (*p).m_duplicate_of = *q;
+                (*q)->m_duplicate_path_indices.push_back((*p).m_pos_path_ast_tuple.m_path_index);
+                break;
+            }
+        }
+        if(!(*p).m_duplicate_of) {
+            bucket.push_back(&(*p));
+            unique_count++;
+        }
     }
-    if(options.expr.empty()) {
-        if(!options.quiet) {
-            std::cerr << "ERROR: mode not supported!" << std::endl;
+    return unique_count;
+}
+
+// sets a flag once deadline_ms have passed since arm(), for parses to poll
+// once per token; a sentence waiting in a queue holds no timer and no thread
+class Deadline
+{
+public:
+    Deadline(size_t deadline_ms)
+        : m_deadline_ms(deadline_ms), m_passed(false), m_done(false), m_started(false)
+    {}
+    ~Deadline()
+    {
+        disarm();
+    }
+    void arm()
+    {
+        if(!m_deadline_ms || m_started) {
+            return;
         }
-        return false;
+        clock_gettime(CLOCK_REALTIME, &m_when);
+        m_when.tv_sec  += m_deadline_ms / 1000;
+        m_when.tv_nsec += (m_deadline_ms % 1000) * 1000000;
+        if(m_when.tv_nsec >= 1000000000) {
+            m_when.tv_sec++;
+            m_when.tv_nsec -= 1000000000;
+        }
+        pthread_mutex_init(&m_mutex, NULL);
+        pthread_cond_init(&m_cond, NULL);
+        m_started = (pthread_create(&m_thread, NULL, watch, this) == 0);
+    }
+    // stops the timer; passed() keeps its last value
+    void disarm()
+    {
+        if(!m_started) {
+            return;
+        }
+        pthread_mutex_lock(&m_mutex);
+        m_done = true;
+        pthread_cond_signal(&m_cond);
+        pthread_mutex_unlock(&m_mutex);
+        pthread_join(m_thread, NULL);
+        pthread_cond_destroy(&m_cond);
+        pthread_mutex_destroy(&m_mutex);
+        m_started = false;
+    }
+    bool passed() const
+    {
+        return m_passed.load(std::memory_order_relaxed);
+    }
+    // valid before arm(), so jobs can be handed it while the sentence is queued
+    const std::atomic<bool>* flag() const
+    {
+        return m_deadline_ms ? &m_passed : NULL;
+    }
+
+private:
+    size_t            m_deadline_ms;
+    std::atomic<bool> m_passed;
+    bool              m_done;
+    bool              m_started;
+    struct timespec   m_when;
+    pthread_t         m_thread;
+    pthread_mutex_t   m_mutex;
+    pthread_cond_t    m_cond;
+
+    static void* watch(void* args)
+    {
+        Deadline* deadline = reinterpret_cast<Deadline*>(args);
+        pthread_mutex_lock(&deadline->m_mutex);
+        while(!deadline->m_done) {
+            if(pthread_cond_timedwait(&deadline->m_cond, &deadline->m_mutex, &deadline->m_when) == ETIMEDOUT) {
+                deadline->m_passed = true;
+                break;
+            }
+        }
+        pthread_mutex_unlock(&deadline->m_mutex);
+        return NULL;
+    }
+};
+
+// prints each sentence's parses as soon as its terminating punctuation is read
+bool apply_stream(options_t &options, xl::MemBudget* process_mem_budget)
+{
+    xl::MemBudget mem_budget(options.mem_budget, process_mem_budget);
+    xl::Allocator alloc(__FILE__);
+    alloc.set_budget(&mem_budget);
+    ParseSession session(alloc, options.flat);
+    std::vector<session_parse_t> parses;
+    int sentence_index = 0;
+    int successful_parse_count = 0;
+    if(options.mode == options_t::MODE_DOT) {
+        std::cout << xl::mvc::MVCView::print_dot_header(false);
+    }
+    std::string word;
+    while(std::cin >> word) {
+        std::string expanded_word = expand_contractions(word);
+        std::vector<std::string> words = xl::tokenize(expanded_word);
+        for(std::vector<std::string>::iterator p = words.begin(); p != words.end(); p++) {
+            std::stringstream error_messages;
+            size_t word_count = session.word_count() + 1;
+            try {
+                if(!session.push_word(*p, &parses, error_messages)) {
+                    continue;
+                }
+            } catch(const char* s) {
+                std::cerr << "ERROR: Sentence #" << sentence_index << ": " << s << std::endl;
+                session.reset();
+                alloc._free();
+                sentence_index++;
+                continue;
+            }
+            if(!options.quiet) {
+                std::cerr << "INFO: Sentence #" << sentence_index << " complete after " << word_count
+                          << " words: " << parses.size() << " parse(s)" << std::endl;
+                std::cerr << error_messages.str();
+            }
+            int path_index = 0;
+            for(std::vector<session_parse_t>::iterator q = parses.begin(); q != parses.end(); q++) {
+                pos_path_ast_tuple_t pos_path_ast_tuple((*q).m_pos_path, (*q).m_ast, path_index++);
+                std::stringstream output, info_messages;
+                export_ast(options, pos_path_ast_tuple, output, info_messages);
+                std::cout << output.str() << std::flush;
+            }
+            successful_parse_count += parses.size();
+            sentence_index++;
+            alloc._free();
+        }
+    }
+    if(options.mode == options_t::MODE_DOT) {
+        std::cout << xl::mvc::MVCView::print_dot_footer();
+    }
+    if(session.word_count() && !options.quiet) {
+        std::cerr << "INFO: " << session.word_count() << " word(s) left without terminating punctuation" << std::endl;
+    }
+    std::cerr << "Info: Successful parse count: " << successful_parse_count << std::endl;
+    return successful_parse_count != 0;
+}
+
+// prints how much of a memory budget was used
+static void print_mem_budget(std::ostream &err, const std::string &name, const xl::MemBudget &mem_budget)
+{
+    err << "INFO: " << name << " memory budget: " << mem_budget.used() << " bytes in use, "
+              << mem_budget.peak() << " bytes peak, ";
+    if(mem_budget.limit()) {
+        err << mem_budget.limit() << " bytes limit" << std::endl;
+    } else {
+        err << "no limit" << std::endl;
+    }
+}
+
+// state every sentence of a run shares
+struct run_context_t
+{
+    options_t*        m_options;
+    xl::MemBudget*    m_process_mem_budget;
+    pos_stats_table_t m_pos_stats_table;
+    pos_stats_table_t m_pos_stats_delta; // what this run added, for a worker to report back
+    pthread_mutex_t   m_pos_stats_mutex; // enumerated from while earlier sentences are printed
+    struct timespec   m_start_time;
+
+    run_context_t(options_t* options, xl::MemBudget* process_mem_budget)
+        : m_options(options),
+          m_process_mem_budget(process_mem_budget)
+    {
+        pthread_mutex_init(&m_pos_stats_mutex, NULL);
+        clock_gettime(CLOCK_MONOTONIC, &m_start_time);
+        if(!options->stats_filename.empty()) {
+            load_pos_stats(&m_pos_stats_table, options->stats_filename); // no file yet means no history
+        }
+    }
+    ~run_context_t()
+    {
+        pthread_mutex_destroy(&m_pos_stats_mutex);
+    }
+    void save_stats()
+    {
+        if(!m_options->stats_filename.empty() && !save_pos_stats(m_pos_stats_table, m_options->stats_filename)) {
+            std::cerr << "ERROR: Failed to save stats to \"" << m_options->stats_filename << "\"" << std::endl;
+        }
+    }
+};
+
+// one sentence on its way through the tag, enumerate, parse and print stages
+struct sentence_context_t
+{
+    enum strategy_t {
+        STRATEGY_INLINE,   // one path, no threads
+        STRATEGY_SERIAL,   // -s
+        STRATEGY_PARALLEL  // batches of NTHREADS
+    };
+
+    run_context_t*                        m_run;
+    options_t                             m_options; // m_options.expr is this sentence
+    int                                   m_sentence_index;
+    uint64_t                              m_estimated_cost;
+    int                                   m_pass_count; // times the scheduler took a cheaper sentence
+    struct timespec                       m_ready_time;
+    Deadline                              m_deadline;
+    xl::MemBudget                         m_mem_budget;
+    xl::Allocator                         m_cons_alloc;
+    xl::ConsContext                       m_cons_context;
+    std::vector<std::vector<std::string>> m_pos_table;
+    uint64_t                              m_path_count;
+    strategy_t                            m_strategy;
+    bool                                  m_beam;
+    bool                                  m_sampled;
+    bool                                  m_ranged;
+    bool                                  m_bounded;
+    bool                                  m_best_first;
+    bool                                  m_hash_cons;
+    std::vector<uint64_t>                 m_path_indices;
+    std::list<std::vector<std::string>>   m_all_paths_str;
+    std::vector<job_context_t>            m_all_jobs;
+    size_t                                m_skeleton_job_count;
+    int                                   m_unique_parse_count;
+    std::stringstream                     m_shared_header;
+    std::stringstream                     m_shared_footer;
+    std::stringstream                     m_log; // stderr, written out in sentence order
+
+    sentence_context_t(run_context_t* run, const std::string &sentence, int sentence_index = 0)
+        : m_run(run),
+          m_options(*run->m_options),
+          m_sentence_index(sentence_index),
+          m_estimated_cost(0),
+          m_pass_count(0),
+          m_deadline(run->m_options->deadline_ms),
+          m_mem_budget(run->m_options->mem_budget, run->m_process_mem_budget),
+          m_cons_alloc(__FILE__),
+          m_cons_context(m_cons_alloc),
+          m_path_count(0),
+          m_strategy(STRATEGY_INLINE),
+          m_beam(false),
+          m_sampled(false),
+          m_ranged(false),
+          m_bounded(false),
+          m_best_first(false),
+          m_hash_cons(false),
+          m_skeleton_job_count(0),
+          m_unique_parse_count(0)
+    {
+        m_options.expr = sentence;
+        m_cons_alloc.set_budget(&m_mem_budget);
+        m_ready_time = run->m_start_time;
+    }
+    void flush_log(std::ostream &err)
+    {
+        err << m_log.str();
+        m_log.str("");
     }
-    std::list<std::vector<std::string>> all_paths_str;
+};
+
+// stage 1: tags each word with its POS options and picks a strategy
+void tag_sentence(sentence_context_t* sc)
+{
+    options_t &options = sc->m_options;
     std::string sentence = options.expr;
 // NOTE: just in case
 #if 1
@@ -1303,54 +2015,211 @@ bool apply_options(options_t &options)
 #endif
     options.expr = sentence = expand_contractions(sentence);
     std::stringstream shared_info_messages;
-    build_pos_paths_from_sentence(&all_paths_str,
+    build_pos_table_from_sentence(&sc->m_pos_table,
                                    sentence,
-                                   shared_info_messages);
+                                   shared_info_messages,
+                                   options.pos_rules);
+    if(!options.quiet) {
+        sc->m_log << shared_info_messages.str();
+    }
+
+    // pick how to run the jobs from the exact path count
+    sc->m_path_count = count_pos_paths(sc->m_pos_table);
+    sc->m_ranged     = options.path_range;
+    sc->m_beam       = !sc->m_ranged && options.beam_width != 0;
+    sc->m_sampled    = !sc->m_ranged && !sc->m_beam && options.sample_count && sc->m_path_count > options.sample_count;
+    uint64_t range_count = !sc->m_ranged ? sc->m_path_count :
+                           (options.path_range_start >= sc->m_path_count) ? 0 :
+                           std::min(options.path_range_end, sc->m_path_count) - options.path_range_start;
+    sc->m_bounded    = !sc->m_beam && !sc->m_sampled && options.max_path_count && range_count > options.max_path_count;
+    sc->m_best_first = !sc->m_ranged && !sc->m_beam && !sc->m_sampled && !options.stats_filename.empty();
+    sc->m_strategy   = (sc->m_path_count == 1) ? sentence_context_t::STRATEGY_INLINE :
+                       options.serial          ? sentence_context_t::STRATEGY_SERIAL :
+                                                 sentence_context_t::STRATEGY_PARALLEL;
+    // NOTE: ontology extraction and dot edges walk parent links, which interned nodes don't have
+    sc->m_hash_cons  = options.hash_cons && options.mode != options_t::MODE_EXTRACT
+                                         && options.mode != options_t::MODE_DOT;
+
+    // what the corpus scheduler orders by: paths that will be tried times their length
+    uint64_t explored_count = sc->m_beam    ? options.beam_width :
+                              sc->m_sampled ? options.sample_count :
+                              sc->m_bounded ? options.max_path_count : range_count;
+    uint64_t word_count = sc->m_pos_table.size();
+    sc->m_estimated_cost = (word_count && explored_count > std::numeric_limits<uint64_t>::max() / word_count) ?
+                           std::numeric_limits<uint64_t>::max() : explored_count * word_count;
+}
+
+// stage 2: enumerates the POS-paths to try, one job each
+void enumerate_paths(sentence_context_t* sc)
+{
+    options_t &options = sc->m_options;
+    run_context_t* run = sc->m_run;
+    std::stringstream shared_info_messages;
+    pthread_mutex_lock(&run->m_pos_stats_mutex);
+    if(sc->m_beam) {
+        build_beam_path_indices(&sc->m_path_indices,
+                                 sc->m_pos_table,
+                                 run->m_pos_stats_table,
+                                 options.beam_width);
+        build_pos_paths_from_path_indices(&sc->m_all_paths_str,
+                                           sc->m_pos_table,
+                                           sc->m_path_indices,
+                                           shared_info_messages);
+    } else if(sc->m_ranged) {
+        // random access: no enumeration of the paths before START
+        range_path_indices(&sc->m_path_indices,
+                            sc->m_path_count,
+                            options.path_range_start,
+                            options.path_range_end,
+                            sc->m_bounded ? options.max_path_count : 0);
+        build_pos_paths_from_path_indices(&sc->m_all_paths_str,
+                                           sc->m_pos_table,
+                                           sc->m_path_indices,
+                                           shared_info_messages);
+    } else if(sc->m_sampled) {
+        sample_path_indices(&sc->m_path_indices, sc->m_path_count, options.sample_count, options.seed);
+        build_pos_paths_from_path_indices(&sc->m_all_paths_str,
+                                           sc->m_pos_table,
+                                           sc->m_path_indices,
+                                           shared_info_messages);
+    } else if(sc->m_best_first) {
+        build_best_first_path_indices(&sc->m_path_indices,
+                                       sc->m_pos_table,
+                                       run->m_pos_stats_table,
+                                       sc->m_bounded ? options.max_path_count : 0);
+        build_pos_paths_from_path_indices(&sc->m_all_paths_str,
+                                           sc->m_pos_table,
+                                           sc->m_path_indices,
+                                           shared_info_messages);
+    } else {
+        build_pos_paths_from_pos_table(&sc->m_all_paths_str,
+                                        sc->m_pos_table,
+                                        shared_info_messages,
+                                        sc->m_bounded ? options.max_path_count : 0);
+    }
+    pthread_mutex_unlock(&run->m_pos_stats_mutex);
     if(!options.quiet) {
-        std::cerr << shared_info_messages.str();
-    }
-    std::stringstream shared_header, shared_footer;
-    int path_index = 0;
-    std::vector<job_context_t> all_jobs;
-    for(std::list<std::vector<std::string>>::iterator p = all_paths_str.begin(); p != all_paths_str.end(); p++) {
-        all_jobs.push_back(job_context_t(&options,
-                                          pos_path_ast_tuple_t(*p, NULL, path_index),
-                                         &shared_header,
-                                         &shared_footer));
+        sc->m_log << shared_info_messages.str();
+        sc->m_log << "INFO: " << sc->m_path_count << " POS-paths, strategy: "
+                  << (sc->m_strategy == sentence_context_t::STRATEGY_INLINE ? "inline" :
+                      sc->m_strategy == sentence_context_t::STRATEGY_SERIAL ? "serial" : "parallel");
+        if(sc->m_sampled) {
+            sc->m_log << " (sampled " << options.sample_count << " with seed " << options.seed << ")";
+        }
+        if(sc->m_ranged) {
+            sc->m_log << " (range " << options.path_range_start << " to "
+                      << (options.path_range_start + sc->m_path_indices.size()) << ")";
+        }
+        if(sc->m_best_first) {
+            sc->m_log << " (best-first)";
+        }
+        if(sc->m_beam) {
+            sc->m_log << " (beam of " << options.beam_width << ", " << sc->m_path_indices.size() << " complete paths accepted)";
+        }
+        if(sc->m_bounded) {
+            sc->m_log << " (bounded to the first " << options.max_path_count << ", "
+                      << (sc->m_path_count - options.max_path_count) << " not explored)";
+        }
+        sc->m_log << std::endl;
+    }
+    size_t path_index = 0;
+    for(std::list<std::vector<std::string>>::iterator p = sc->m_all_paths_str.begin(); p != sc->m_all_paths_str.end(); p++) {
+        sc->m_all_jobs.push_back(job_context_t(&options,
+                                                pos_path_ast_tuple_t(*p, NULL, sc->m_path_indices.size() ? sc->m_path_indices[path_index] : path_index),
+                                               &sc->m_shared_header,
+                                               &sc->m_shared_footer,
+                                                sc->m_hash_cons ? &sc->m_cons_context : NULL,
+                                                sc->m_deadline.flag(),
+                                               &sc->m_mem_budget));
         path_index++;
     }
-    if(options.serial) {
+    std::map<std::vector<uint32_t>, job_context_t*> lexer_id_path_to_job;
+    for(std::vector<job_context_t>::iterator p = sc->m_all_jobs.begin(); p != sc->m_all_jobs.end(); p++) {
+        std::vector<std::string> &pos_path = (*p).m_pos_path_ast_tuple.m_pos_path;
+        std::vector<uint32_t> pos_lexer_id_path;
+        try {
+            for(std::vector<std::string>::const_iterator q = pos_path.begin(); q != pos_path.end(); q++) {
+                pos_lexer_id_path.push_back(name_to_id(*q));
+            }
+        } catch(const char* s) {
+            sc->m_skeleton_job_count++; // parse it alone, the job reports the error
+            continue;
+        }
+        job_context_t* &skeleton_job = lexer_id_path_to_job[pos_lexer_id_path];
+        if(skeleton_job) {
+            (*p).m_skeleton_of = skeleton_job;
+        } else {
+            skeleton_job = &(*p);
+            sc->m_skeleton_job_count++;
+        }
+    }
+    if(!options.quiet) {
+        sc->m_log << "INFO: " << sc->m_all_jobs.size() << " POS-paths share " << sc->m_skeleton_job_count << " lexer-id paths" << std::endl;
+    }
+}
+
+// stage 3: parses the jobs and renders their ASTs
+void parse_paths(sentence_context_t* sc)
+{
+    options_t &options = sc->m_options;
+    std::vector<job_context_t> &all_jobs = sc->m_all_jobs;
+    sc->m_deadline.arm(); // not before, or time spent queued behind other sentences would count
+    if(options.deadline_ms && sc->m_pass_count && !options.quiet) {
+        sc->m_log << "INFO: Scheduler passed sentence #" << sc->m_sentence_index << " over " << sc->m_pass_count
+                  << " time(s); its deadline of " << options.deadline_ms << " ms starts now" << std::endl;
+    }
+    if(sc->m_strategy == sentence_context_t::STRATEGY_INLINE) {
+        {
+            std::string msg = "Step 3/4. Parse POS-path Inline:";
+            std::string bar = std::string(msg.length(), '=');
+            sc->m_log << std::endl << bar << std::endl << msg << std::endl << bar << std::endl << std::endl;
+        }
+
+        if(all_jobs.size()) {
+            do_job(&all_jobs[0]);
+        }
+    } else if(sc->m_strategy == sentence_context_t::STRATEGY_SERIAL) {
         {
             std::string msg = "Step 3/4. Parse POS-paths in Serial:";
             std::string bar = std::string(msg.length(), '=');
-            std::cerr << std::endl << bar << std::endl << msg << std::endl << bar << std::endl << std::endl;
+            sc->m_log << std::endl << bar << std::endl << msg << std::endl << bar << std::endl << std::endl;
         }
 
-        int path_index = 0;
         for(std::vector<job_context_t>::iterator p = all_jobs.begin(); p != all_jobs.end(); p++) {
-            std::cerr << "INFO: Processing path #" << path_index << std::endl;
-            do_job(&(*p));
-            path_index++;
+            if(sc->m_deadline.passed()) {
+                break;
+            }
+            if(!(*p).m_skeleton_of) {
+                sc->m_log << "INFO: Processing path #" << (*p).m_pos_path_ast_tuple.m_path_index << std::endl;
+                do_job(&(*p));
+            }
         }
     } else {
         {
             std::string msg = "Step 3/4. Parse POS-paths in Parallel:";
             std::string bar = std::string(msg.length(), '=');
-            std::cerr << std::endl << bar << std::endl << msg << std::endl << bar << std::endl << std::endl;
+            sc->m_log << std::endl << bar << std::endl << msg << std::endl << bar << std::endl << std::endl;
         }
 
-        size_t job_count = all_jobs.size();
+        size_t job_count = sc->m_skeleton_job_count;
         int batch_count = std::max(job_count, job_count - 1) / NTHREADS + 1;
         if(!options.quiet) {
-            std::cerr << "INFO: Processing " << all_jobs.size() << " jobs in " << batch_count << " batches.." << std::endl;
+            sc->m_log << "INFO: Processing " << job_count << " jobs in " << batch_count << " batches.." << std::endl;
         }
         int batch_index = 1;
         std::vector<job_context_t*> batch_jobs;
         for(std::vector<job_context_t>::iterator q = all_jobs.begin(); q != all_jobs.end(); q++) {
+            if(sc->m_deadline.passed()) {
+                batch_jobs.clear(); // no new paths once the deadline passes
+                break;
+            }
+            if((*q).m_skeleton_of) {
+                continue;
+            }
             batch_jobs.push_back(&(*q));
             if(batch_jobs.size() >= NTHREADS) {
                 if(!options.quiet) {
-                    std::cerr << "INFO: Processing batch " << batch_index << "/" << batch_count << " with " << batch_jobs.size() << " jobs.." << std::endl;
+                    sc->m_log << "INFO: Processing batch " << batch_index << "/" << batch_count << " with " << batch_jobs.size() << " jobs.." << std::endl;
                 }
                 process_batch_jobs(batch_jobs);
                 batch_jobs.clear();
@@ -1359,44 +2228,833 @@ bool apply_options(options_t &options)
         }
         if(batch_jobs.size()) {
             if(!options.quiet) {
-                std::cerr << "INFO: Processing batch " << batch_index << "/" << batch_count << " with " << batch_jobs.size() << " jobs.." << std::endl;
+                sc->m_log << "INFO: Processing batch " << batch_index << "/" << batch_count << " with " << batch_jobs.size() << " jobs.." << std::endl;
             }
             process_batch_jobs(batch_jobs);
             batch_jobs.clear();
             batch_index++;
         }
         if(!options.quiet) {
-            std::cerr << "INFO: Successfully processed " << all_jobs.size() << " jobs in " << batch_count << " batches.." << std::endl;
+            sc->m_log << "INFO: Successfully processed " << job_count << " jobs in " << batch_count << " batches.." << std::endl;
+        }
+    }
+    for(std::vector<job_context_t>::iterator p = all_jobs.begin(); p != all_jobs.end(); p++) {
+        if((*p).m_skeleton_of && !sc->m_deadline.passed()) {
+            do_job(&(*p));
+        }
+    }
+
+    if(options.unique) {
+        sc->m_unique_parse_count = dedupe_jobs(all_jobs);
+        for(std::vector<job_context_t>::iterator q = all_jobs.begin(); q != all_jobs.end(); q++) {
+            pos_path_ast_tuple_t &pos_path_ast_tuple = (*q).m_pos_path_ast_tuple;
+            if((*q).m_duplicate_of) {
+                (*q).m_info_messages << "INFO: Path #" << pos_path_ast_tuple.m_path_index << " duplicates path #"
+                                     << (*q).m_duplicate_of->m_pos_path_ast_tuple.m_path_index << std::endl;
+                continue;
+            }
+            if(!pos_path_ast_tuple.m_ast) {
+                continue;
+            }
+            if((*q).m_duplicate_path_indices.size()) {
+                (*q).m_info_messages << "INFO: Path #" << pos_path_ast_tuple.m_path_index << " also produced by path(s)";
+                for(std::vector<uint64_t>::iterator r = (*q).m_duplicate_path_indices.begin();
+                        r != (*q).m_duplicate_path_indices.end(); r++)
+                {
+                    (*q).m_info_messages << " #" << *r;
+                }
+                (*q).m_info_messages << std::endl;
+            }
+            export_job(&(*q));
         }
     }
+    sc->m_deadline.disarm(); // parsed sentences can wait a while in the reorder buffer
+    clock_gettime(CLOCK_MONOTONIC, &sc->m_ready_time);
+}
+
+// stage 4: prints the sentence's ASTs and summary; true if anything parsed
+bool print_sentence(sentence_context_t* sc, std::ostream &out, std::ostream &err)
+{
+    options_t &options = sc->m_options;
+    run_context_t* run = sc->m_run;
+    std::vector<job_context_t> &all_jobs = sc->m_all_jobs;
+    sc->flush_log(err);
 
     {
         std::string msg = "Step 4/4. Print ASTs:";
         std::string bar = std::string(msg.length(), '=');
-        std::cerr << std::endl << bar << std::endl << msg << std::endl << bar << std::endl << std::endl;
+        err << std::endl << bar << std::endl << msg << std::endl << bar << std::endl << std::endl;
     }
 
     int successful_parse_count = 0;
-    std::cout << shared_header.str();
+    out << sc->m_shared_header.str();
+    pthread_mutex_lock(&run->m_pos_stats_mutex);
     for(std::vector<job_context_t>::iterator r = all_jobs.begin(); r != all_jobs.end(); r++) {
         if(!options.quiet) {
-            std::cerr << (*r).m_info_messages.str();
-            std::cerr << (*r).m_error_messages.str();
+            err << (*r).m_info_messages.str();
+            err << (*r).m_error_messages.str();
         }
-        std::cout << (*r).m_output.str();
+        out << (*r).m_output.str();
         if((*r).m_pos_path_ast_tuple.m_ast) {
             successful_parse_count++;
         }
+        if((*r).m_completed) { // a path cut short by the deadline or budget says nothing about its tags
+            update_pos_stats(&run->m_pos_stats_table, (*r).m_pos_path_ast_tuple.m_pos_path, (*r).m_pos_path_ast_tuple.m_ast != NULL);
+            if(options.process_mode && !options.stats_filename.empty()) {
+                update_pos_stats(&run->m_pos_stats_delta, (*r).m_pos_path_ast_tuple.m_pos_path, (*r).m_pos_path_ast_tuple.m_ast != NULL);
+            }
+        }
+    }
+    pthread_mutex_unlock(&run->m_pos_stats_mutex);
+    out << sc->m_shared_footer.str();
+    if(sc->m_hash_cons && options.dump_memory && !options.quiet) {
+        err << "INFO: Hash-consed ASTs: " << sc->m_cons_context.unique_count() << " unique nodes in "
+                  << sc->m_cons_context.unique_bytes() << " bytes (plus " << sc->m_cons_context.index_bytes()
+                  << " bytes of index), " << sc->m_cons_context.shared_count()
+                  << " shared nodes saved " << sc->m_cons_context.shared_bytes() << " bytes" << std::endl;
+    }
+    if((options.dump_memory || options.mem_budget || options.process_mem_budget) && !options.quiet) {
+        print_mem_budget(err, "Sentence", sc->m_mem_budget);
+        if(run->m_process_mem_budget) {
+            print_mem_budget(err, "Process", *run->m_process_mem_budget);
+        }
+    }
+    int over_budget_count = 0;
+    for(std::vector<job_context_t>::iterator r = all_jobs.begin(); r != all_jobs.end(); r++) {
+        if((*r).m_over_budget) {
+            over_budget_count++;
+        }
+    }
+    if(over_budget_count) {
+        err << "Info: Memory budget exceeded, " << over_budget_count << " parse(s) aborted" << std::endl;
+    }
+    if(sc->m_deadline.passed()) {
+        // counted against the paths selected for this sentence (all of them, a
+        // bound, a sample, a beam or a range), which are exactly the jobs
+        uint64_t unexplored_count = 0;
+        int cancelled_count = 0;
+        for(std::vector<job_context_t>::iterator r = all_jobs.begin(); r != all_jobs.end(); r++) {
+            if(!(*r).m_dispatched) {
+                unexplored_count++;
+            } else if((*r).m_cancelled) {
+                cancelled_count++;
+            }
+        }
+        err << "Info: Deadline of " << options.deadline_ms << " ms passed: " << cancelled_count << " parse(s) cancelled, "
+                  << unexplored_count << " path(s) not explored" << std::endl;
     }
-    std::cout << shared_footer.str();
     if(!successful_parse_count) {
-        std::cerr << "Info: Parse fail!" << std::endl;
+        err << "Info: Parse fail!" << std::endl;
         return false;
     }
-    std::cerr << "Info: Successful parse count: " << successful_parse_count << std::endl;
+    err << "Info: Successful parse count: " << successful_parse_count << std::endl;
+    if(options.unique) {
+        err << "Info: Unique parse count: " << sc->m_unique_parse_count << std::endl;
+    }
+    return true;
+}
+
+typedef xl::BoundedQueue<sentence_context_t*> sentence_queue_t;
+
+struct corpus_reader_t
+{
+    run_context_t*    m_run;
+    std::istream*     m_in;
+    sentence_queue_t* m_out;
+};
+
+struct pipeline_stage_t
+{
+    void              (*m_stage)(sentence_context_t*);
+    sentence_queue_t* m_in;
+    sentence_queue_t* m_out;
+};
+
+// feeds the pipeline one sentence per non-blank line, then a NULL to end it
+void* read_corpus(void* args)
+{
+    corpus_reader_t* reader = reinterpret_cast<corpus_reader_t*>(args);
+    int sentence_index = 0;
+    std::string line;
+    while(std::getline(*reader->m_in, line)) {
+        if(line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        sentence_context_t* sc = new sentence_context_t(reader->m_run, line, sentence_index);
+        if(!sc->m_options.quiet) {
+            sc->m_log << "INFO: Sentence #" << sentence_index << ": " << line << std::endl;
+        }
+        reader->m_out->push(sc);
+        sentence_index++;
+    }
+    reader->m_out->push(NULL);
+    return NULL;
+}
+
+void* do_stage(void* args)
+{
+    pipeline_stage_t* stage = reinterpret_cast<pipeline_stage_t*>(args);
+    sentence_context_t* sc = NULL;
+    while((sc = stage->m_in->pop())) {
+        stage->m_stage(sc);
+        stage->m_out->push(sc);
+    }
+    stage->m_out->push(NULL);
+    return NULL;
+}
+
+// a sentence's estimated cost halves every SCHEDULE_AGING times the scheduler
+// passes it over, so an expensive one can't be starved by a stream of cheap ones
+static uint64_t aged_cost(const sentence_context_t* sc)
+{
+    int shift = sc->m_pass_count / SCHEDULE_AGING;
+    return (shift >= 64) ? 0 : (sc->m_estimated_cost >> shift);
+}
+
+// shortest estimated job first, oldest first among equals; the NULL end
+// marker is only handed out once nothing else is left
+static std::deque<sentence_context_t*>::iterator pick_cheapest_sentence(std::deque<sentence_context_t*> &queue)
+{
+    std::deque<sentence_context_t*>::iterator cheapest = queue.end();
+    for(std::deque<sentence_context_t*>::iterator p = queue.begin(); p != queue.end(); p++) {
+        if(*p && (cheapest == queue.end() || aged_cost(*p) < aged_cost(*cheapest))) {
+            cheapest = p;
+        }
+    }
+    if(cheapest == queue.end()) {
+        return queue.begin();
+    }
+    for(std::deque<sentence_context_t*>::iterator q = queue.begin(); q != queue.end(); q++) {
+        if(*q && q != cheapest) {
+            (*q)->m_pass_count++;
+        }
+    }
+    return cheapest;
+}
+
+static double elapsed_ms(const struct timespec &from, const struct timespec &to)
+{
+    return (to.tv_sec - from.tv_sec) * 1000.0 + (to.tv_nsec - from.tv_nsec) / 1000000.0;
+}
+
+// nearest-rank percentile
+static double percentile(std::vector<double> values, int pct)
+{
+    if(values.empty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[(values.size() - 1) * pct / 100];
+}
+
+// sentence i+1 is tagged while sentence i is parsed and sentence i-1 printed;
+// cheap sentences are parsed ahead of expensive ones unless --fifo, and a
+// reorder buffer still prints them in input order
+bool apply_corpus(options_t &options, xl::MemBudget* process_mem_budget)
+{
+    std::ifstream corpus_file;
+    std::istream* in = &std::cin;
+    if(options.corpus_filename != "-") {
+        corpus_file.open(options.corpus_filename.c_str());
+        if(!corpus_file) {
+            std::cerr << "ERROR: Failed to open corpus \"" << options.corpus_filename << "\"" << std::endl;
+            return false;
+        }
+        in = &corpus_file;
+    }
+    run_context_t run(&options, process_mem_budget);
+    sentence_queue_t read_queue(PIPELINE_DEPTH);
+    sentence_queue_t tagged_queue(options.fifo ? PIPELINE_DEPTH : SCHEDULE_WINDOW,
+                                  options.fifo ? NULL : pick_cheapest_sentence);
+    sentence_queue_t enumerated_queue(PIPELINE_DEPTH);
+    sentence_queue_t parsed_queue(PIPELINE_DEPTH);
+    corpus_reader_t reader = { &run, in, &read_queue };
+    pipeline_stage_t stages[] = { { tag_sentence,    &read_queue,       &tagged_queue     },
+                                  { enumerate_paths, &tagged_queue,     &enumerated_queue },
+                                  { parse_paths,     &enumerated_queue, &parsed_queue     } };
+    const int stage_count = sizeof(stages) / sizeof(*stages);
+    pthread_t reader_thread;
+    pthread_t stage_threads[stage_count];
+    if(pthread_create(&reader_thread, NULL, read_corpus, &reader) != 0) {
+        fprintf(stderr, "ERROR: Failed to create reader thread\n");
+        return false;
+    }
+    for(int i = 0; i < stage_count; i++) {
+        if(pthread_create(&stage_threads[i], NULL, do_stage, &stages[i]) != 0) {
+            fprintf(stderr, "ERROR: Failed to create stage thread: %d\n", i);
+            exit(EXIT_FAILURE); // upstream stages would block on a full queue forever
+        }
+    }
+    int sentence_count = 0;
+    int parsed_sentence_count = 0;
+    std::map<int, sentence_context_t*> reorder_buffer; // parsed but not yet printed, by input order
+    std::vector<double> ready_latencies, printed_latencies;
+    sentence_context_t* sc = NULL;
+    while((sc = parsed_queue.pop())) {
+        reorder_buffer[sc->m_sentence_index] = sc;
+        std::map<int, sentence_context_t*>::iterator p;
+        while((p = reorder_buffer.find(sentence_count)) != reorder_buffer.end()) {
+            sc = (*p).second;
+            reorder_buffer.erase(p);
+            if(print_sentence(sc, std::cout, std::cerr)) {
+                parsed_sentence_count++;
+            }
+            struct timespec printed_time;
+            clock_gettime(CLOCK_MONOTONIC, &printed_time);
+            ready_latencies.push_back(elapsed_ms(run.m_start_time, sc->m_ready_time));
+            printed_latencies.push_back(elapsed_ms(run.m_start_time, printed_time));
+            sentence_count++;
+            delete sc;
+        }
+    }
+    pthread_join(reader_thread, NULL);
+    for(int j = 0; j < stage_count; j++) {
+        pthread_join(stage_threads[j], NULL);
+    }
+    run.save_stats();
+    std::cerr << "Info: " << parsed_sentence_count << "/" << sentence_count << " sentences parsed" << std::endl;
+    std::cerr << "Info: Sentence latency p50/p99 (" << (options.fifo ? "fifo" : "cheapest first") << "): "
+              << percentile(ready_latencies, 50) << "/" << percentile(ready_latencies, 99) << " ms to parse, "
+              << percentile(printed_latencies, 50) << "/" << percentile(printed_latencies, 99) << " ms to print" << std::endl;
+    return parsed_sentence_count != 0;
+}
+
+// a sentence handed to a worker; sentence index -1 tells the worker to exit
+struct worker_task_t
+{
+    int32_t  m_sentence_index;
+    uint32_t m_length;
+    char     m_text[WORKER_TASK_BYTES];
+};
+
+// how a worker's result is laid out in its ring, ahead of its stdout, stderr
+// and stats bytes; the stats are the counts the sentence added, in the
+// format of the --stats file
+struct worker_result_header_t
+{
+    int32_t  m_sentence_index;
+    int32_t  m_success;
+    uint64_t m_out_length;
+    uint64_t m_err_length;
+    uint64_t m_stats_length;
+};
+
+// what the spawner reports about one worker; small enough for one atomic pipe write
+struct spawner_event_t
+{
+    int32_t m_worker_index;
+    int32_t m_pid;    // -1 if the fork failed
+    int32_t m_exited; // 0 when started, 1 when reaped
+    int32_t m_status; // from waitpid, once reaped
+};
+
+// shared memory between the coordinator and one worker; each ring has one
+// writer and one reader, so neither needs a lock a crashed worker could hold
+struct worker_channel_t
+{
+    std::atomic<int32_t>  m_busy_sentence_index; // -1 while idle
+    std::atomic<uint64_t> m_task_head;
+    std::atomic<uint64_t> m_task_tail;
+    worker_task_t         m_tasks[WORKER_TASK_SLOTS];
+    std::atomic<uint64_t> m_result_head;
+    std::atomic<uint64_t> m_result_tail;
+    char                  m_results[WORKER_RING_BYTES];
+
+    void reset()
+    {
+        m_busy_sentence_index = -1;
+        m_task_head   = 0;
+        m_task_tail   = 0;
+        m_result_head = 0;
+        m_result_tail = 0;
+    }
+};
+
+struct worker_result_t
+{
+    bool        m_success;
+    std::string m_out;
+    std::string m_err;
+
+    worker_result_t(bool success = false, const std::string &out = "", const std::string &err = "")
+        : m_success(success), m_out(out), m_err(err) {}
+};
+
+// the coordinator's view of one worker
+struct worker_t
+{
+    pid_t           m_pid;         // 0 until the spawner reports it started
+    bool            m_restarted;
+    std::deque<int> m_outstanding; // sentences sent and not yet answered, oldest first
+    std::string     m_buffer;      // result bytes read from the ring, up to a partial record
+
+    worker_t()
+        : m_pid(0), m_restarted(false) {}
+};
+
+// blocks while the ring is full
+static void write_result_ring(worker_channel_t* channel, const char* data, size_t length)
+{
+    while(length) {
+        uint64_t head = channel->m_result_head.load(std::memory_order_relaxed);
+        uint64_t tail = channel->m_result_tail.load(std::memory_order_acquire);
+        size_t offset = head % WORKER_RING_BYTES;
+        size_t n = std::min<uint64_t>(length, WORKER_RING_BYTES - (head - tail));
+        n = std::min<size_t>(n, WORKER_RING_BYTES - offset); // up to the wrap
+        if(!n) {
+            usleep(WORKER_POLL_US);
+            continue;
+        }
+        memcpy(channel->m_results + offset, data, n);
+        channel->m_result_head.store(head + n, std::memory_order_release);
+        data   += n;
+        length -= n;
+    }
+}
+
+// appends what the worker has written so far; false if there was nothing
+static bool read_result_ring(worker_channel_t* channel, std::string* buffer)
+{
+    uint64_t tail = channel->m_result_tail.load(std::memory_order_relaxed);
+    uint64_t head = channel->m_result_head.load(std::memory_order_acquire);
+    if(head == tail) {
+        return false;
+    }
+    while(tail != head) {
+        size_t offset = tail % WORKER_RING_BYTES;
+        size_t n = std::min<uint64_t>(head - tail, WORKER_RING_BYTES - offset);
+        buffer->append(channel->m_results + offset, n);
+        tail += n;
+    }
+    channel->m_result_tail.store(tail, std::memory_order_release);
     return true;
 }
 
+// the coordinator never sends more than WORKER_TASK_SLOTS at once, so there is always room
+static void push_task(worker_channel_t* channel, int sentence_index, const std::string &sentence)
+{
+    uint64_t head = channel->m_task_head.load(std::memory_order_relaxed);
+    worker_task_t &task = channel->m_tasks[head % WORKER_TASK_SLOTS];
+    task.m_sentence_index = sentence_index;
+    task.m_length = sentence.length();
+    memcpy(task.m_text, sentence.c_str(), sentence.length());
+    channel->m_task_head.store(head + 1, std::memory_order_release);
+}
+
+static void run_worker(options_t &options, worker_channel_t* channel)
+{
+    xl::MemBudget process_mem_budget(options.process_mem_budget);
+    run_context_t run(&options, &process_mem_budget);
+    for(;;) {
+        uint64_t tail = channel->m_task_tail.load(std::memory_order_relaxed);
+        if(tail == channel->m_task_head.load(std::memory_order_acquire)) {
+            usleep(WORKER_POLL_US);
+            continue;
+        }
+        const worker_task_t &task = channel->m_tasks[tail % WORKER_TASK_SLOTS];
+        int sentence_index = task.m_sentence_index;
+        std::string sentence(task.m_text, sentence_index < 0 ? 0 : task.m_length);
+        channel->m_busy_sentence_index = sentence_index; // before the slot is given back
+        channel->m_task_tail.store(tail + 1, std::memory_order_release);
+        if(sentence_index < 0) {
+            break;
+        }
+        std::stringstream out, err;
+        bool success = false;
+        {
+            sentence_context_t sc(&run, sentence, sentence_index);
+            if(!options.quiet) {
+                sc.m_log << "INFO: Sentence #" << sentence_index << ": " << sentence << std::endl;
+            }
+            tag_sentence(&sc);
+            enumerate_paths(&sc);
+            parse_paths(&sc);
+            success = print_sentence(&sc, out, err);
+        }
+        std::stringstream stats;
+        write_pos_stats(run.m_pos_stats_delta, stats);
+        run.m_pos_stats_delta.clear();
+        std::string out_str   = out.str();
+        std::string err_str   = err.str();
+        std::string stats_str = stats.str();
+        worker_result_header_t header;
+        header.m_sentence_index = sentence_index;
+        header.m_success        = success;
+        header.m_out_length     = out_str.length();
+        header.m_err_length     = err_str.length();
+        header.m_stats_length   = stats_str.length();
+        write_result_ring(channel, reinterpret_cast<const char*>(&header), sizeof(header));
+        write_result_ring(channel, out_str.c_str(), out_str.length());
+        write_result_ring(channel, err_str.c_str(), err_str.length());
+        write_result_ring(channel, stats_str.c_str(), stats_str.length());
+        channel->m_busy_sentence_index = -1;
+    }
+}
+
+// forks every worker on the coordinator's behalf and reaps them. It is forked
+// itself before the coordinator starts any thread and never starts one, so a
+// worker is never forked from a process whose other threads could hold the
+// locks of malloc or iostreams. Reads a worker index per start request; ends
+// once requests are closed and every worker is reaped.
+static void run_spawner(options_t        &options,
+                        worker_channel_t* channels,
+                        size_t            worker_count,
+                        int               request_fd,
+                        int               event_fd)
+{
+    std::vector<pid_t> pids(worker_count, 0);
+    bool accepting = true;
+    for(;;) {
+        struct pollfd request_poll = { request_fd, POLLIN, 0 };
+        if(!accepting) {
+            usleep(WORKER_POLL_US);
+        } else if(poll(&request_poll, 1, std::max(1, WORKER_POLL_US / 1000)) > 0) {
+            int32_t worker_index = 0;
+            if(read(request_fd, &worker_index, sizeof(worker_index)) != sizeof(worker_index)) {
+                accepting = false; // the coordinator is done
+            } else {
+                pid_t pid = fork();
+                if(!pid) {
+                    close(request_fd);
+                    close(event_fd);
+                    run_worker(options, &channels[worker_index]);
+                    _exit(EXIT_SUCCESS);
+                }
+                pids[worker_index] = pid;
+                spawner_event_t event = { worker_index, pid, 0, 0 };
+                write(event_fd, &event, sizeof(event));
+            }
+        }
+        int status = 0;
+        pid_t pid = 0;
+        while((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+            int32_t k = std::find(pids.begin(), pids.end(), pid) - pids.begin();
+            spawner_event_t event = { k, pid, 1, status };
+            write(event_fd, &event, sizeof(event));
+        }
+        if(!accepting && pid < 0) {
+            break; // no children left
+        }
+    }
+}
+
+// false if no event is waiting (and wait is false) or the spawner is gone
+static bool read_spawner_event(int event_fd, spawner_event_t* event, bool wait)
+{
+    struct pollfd event_poll = { event_fd, POLLIN, 0 };
+    if(!wait && poll(&event_poll, 1, 0) <= 0) {
+        return false;
+    }
+    return read(event_fd, event, sizeof(*event)) == sizeof(*event);
+}
+
+// the worker's slot is idle by now, so its rings can start over before the spawner forks
+static void start_worker(int request_fd, worker_channel_t* channels, int32_t worker_index)
+{
+    channels[worker_index].reset();
+    if(write(request_fd, &worker_index, sizeof(worker_index)) != sizeof(worker_index)) {
+        std::cerr << "ERROR: Failed to request worker #" << worker_index << std::endl;
+        exit(EXIT_FAILURE); // the started ones would wait for work forever
+    }
+}
+
+// moves every complete record out of a worker's buffer
+static void collect_results(worker_t*                          worker,
+                            worker_channel_t*                  channel,
+                            std::map<int, worker_result_t>*    reorder_buffer,
+                            std::map<int, std::string>*        sentences,
+                            pos_stats_table_t*                 pos_stats_table)
+{
+    read_result_ring(channel, &worker->m_buffer);
+    while(worker->m_buffer.length() >= sizeof(worker_result_header_t)) {
+        worker_result_header_t header;
+        memcpy(&header, worker->m_buffer.c_str(), sizeof(header));
+        size_t record_length = sizeof(header) + header.m_out_length + header.m_err_length + header.m_stats_length;
+        if(worker->m_buffer.length() < record_length) {
+            break;
+        }
+        (*reorder_buffer)[header.m_sentence_index] = worker_result_t(header.m_success,
+                worker->m_buffer.substr(sizeof(header), header.m_out_length),
+                worker->m_buffer.substr(sizeof(header) + header.m_out_length, header.m_err_length));
+        if(header.m_stats_length) {
+            std::istringstream stats(worker->m_buffer.substr(sizeof(header) + header.m_out_length + header.m_err_length,
+                                                             header.m_stats_length));
+            pos_stats_table_t delta;
+            read_pos_stats(&delta, stats);
+            merge_pos_stats(pos_stats_table, delta);
+        }
+        worker->m_buffer.erase(0, record_length);
+        sentences->erase(header.m_sentence_index);
+        std::deque<int>::iterator p = std::find(worker->m_outstanding.begin(), worker->m_outstanding.end(),
+                                                header.m_sentence_index);
+        if(p != worker->m_outstanding.end()) {
+            worker->m_outstanding.erase(p);
+        }
+    }
+}
+
+typedef xl::BoundedQueue<std::string*> line_queue_t;
+
+struct line_reader_t
+{
+    std::istream* m_in;
+    line_queue_t* m_out;
+};
+
+// feeds the coordinator one non-blank line at a time, then a NULL to end it,
+// so a slow input stream never stalls the result and crash polling
+void* read_lines(void* args)
+{
+    line_reader_t* reader = reinterpret_cast<line_reader_t*>(args);
+    std::string line;
+    while(std::getline(*reader->m_in, line)) {
+        if(line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        reader->m_out->push(new std::string(line));
+    }
+    reader->m_out->push(NULL);
+    return NULL;
+}
+
+// one process per worker, so a bad parse takes down one sentence and not the
+// run; the coordinator hands out sentences, prints results in input order and
+// restarts workers that die
+bool apply_workers(options_t &options)
+{
+    std::ifstream corpus_file;
+    std::istringstream expr_stream(options.expr);
+    std::istream* in = &expr_stream;
+    if(options.corpus_filename == "-") {
+        in = &std::cin;
+    } else if(!options.corpus_filename.empty()) {
+        corpus_file.open(options.corpus_filename.c_str());
+        if(!corpus_file) {
+            std::cerr << "ERROR: Failed to open corpus \"" << options.corpus_filename << "\"" << std::endl;
+            return false;
+        }
+        in = &corpus_file;
+    }
+    size_t worker_count = options.worker_count;
+    if(!worker_count) {
+        long cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+        worker_count = (cpu_count > 0) ? cpu_count : 1;
+    }
+    size_t shared_size = worker_count * sizeof(worker_channel_t);
+    void* shared = mmap(NULL, shared_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if(shared == MAP_FAILED) {
+        std::cerr << "ERROR: Failed to map " << shared_size << " bytes for " << worker_count << " workers" << std::endl;
+        return false;
+    }
+    worker_channel_t* channels = reinterpret_cast<worker_channel_t*>(shared);
+    for(size_t i = 0; i < worker_count; i++) {
+        new (&channels[i]) worker_channel_t;
+    }
+    run_context_t run(&options, NULL); // only for the stats the workers report
+
+    // the spawner must be forked while this process has no other thread
+    int request_pipe[2];
+    int event_pipe[2];
+    if(pipe(request_pipe) != 0 || pipe(event_pipe) != 0) {
+        std::cerr << "ERROR: Failed to create spawner pipes" << std::endl;
+        return false;
+    }
+    std::cout.flush(); // or the children would write the parent's buffered output again
+    std::cerr.flush();
+    pid_t spawner_pid = fork();
+    if(spawner_pid < 0) {
+        std::cerr << "ERROR: Failed to fork spawner" << std::endl;
+        return false;
+    }
+    if(!spawner_pid) {
+        close(request_pipe[1]);
+        close(event_pipe[0]);
+        run_spawner(options, channels, worker_count, request_pipe[0], event_pipe[1]);
+        _exit(EXIT_SUCCESS);
+    }
+    close(request_pipe[0]);
+    close(event_pipe[1]);
+    int request_fd = request_pipe[1];
+    int event_fd   = event_pipe[0];
+    std::vector<worker_t> workers(worker_count);
+    for(size_t i = 0; i < worker_count; i++) {
+        start_worker(request_fd, channels, i);
+    }
+
+    line_queue_t line_queue(worker_count * WORKER_TASK_SLOTS);
+    line_reader_t reader = { in, &line_queue };
+    pthread_t reader_thread;
+    if(pthread_create(&reader_thread, NULL, read_lines, &reader) != 0) {
+        std::cerr << "ERROR: Failed to create reader thread" << std::endl;
+        exit(EXIT_FAILURE); // the workers would wait for work forever
+    }
+
+    std::map<int, std::string>     sentences; // sent and not yet answered, by sentence index
+    std::deque<int>                resend;    // sentences a dead worker never started
+    std::map<int, worker_result_t> reorder_buffer;
+    int  sentence_count        = 0;
+    int  printed_count         = 0;
+    int  parsed_sentence_count = 0;
+    int  restart_count         = 0;
+    bool input_done            = false;
+    for(;;) {
+        bool idle = true;
+        for(size_t i = 0; i < worker_count; i++) {
+            while(workers[i].m_outstanding.size() < WORKER_TASK_SLOTS) {
+                int sentence_index = 0;
+                std::string* line = NULL;
+                if(resend.size()) {
+                    sentence_index = resend.front();
+                    resend.pop_front();
+                } else if(!input_done && line_queue.try_pop(&line)) {
+                    if(!line) {
+                        input_done = true;
+                        break;
+                    }
+                    sentence_index = sentence_count++;
+                    sentences[sentence_index] = *line;
+                    delete line;
+                } else {
+                    break; // nothing to send until more input arrives
+                }
+                if(sentences[sentence_index].length() > WORKER_TASK_BYTES) {
+                    std::stringstream ss;
+                    ss << "ERROR: Sentence #" << sentence_index << " is longer than " << WORKER_TASK_BYTES << " bytes" << std::endl;
+                    reorder_buffer[sentence_index] = worker_result_t(false, "", ss.str());
+                    sentences.erase(sentence_index);
+                    continue;
+                }
+                push_task(&channels[i], sentence_index, sentences[sentence_index]);
+                workers[i].m_outstanding.push_back(sentence_index);
+                idle = false;
+            }
+        }
+        for(size_t j = 0; j < worker_count; j++) {
+            size_t outstanding_count = workers[j].m_outstanding.size();
+            collect_results(&workers[j], &channels[j], &reorder_buffer, &sentences, &run.m_pos_stats_table);
+            if(workers[j].m_outstanding.size() != outstanding_count) {
+                idle = false;
+            }
+        }
+        spawner_event_t event;
+        while(read_spawner_event(event_fd, &event, false)) {
+            int k = event.m_worker_index;
+            pid_t pid = event.m_pid;
+            idle = false;
+            if(!event.m_exited) {
+                if(pid < 0) {
+                    std::cerr << "ERROR: Failed to " << (workers[k].m_restarted ? "restart" : "fork")
+                              << " worker #" << k << std::endl;
+                    exit(EXIT_FAILURE); // the started ones would wait for work forever
+                }
+                workers[k].m_pid = pid;
+                if(!options.quiet) {
+                    std::cerr << "INFO: Worker #" << k << (workers[k].m_restarted ? " restarted" : " started")
+                              << " as pid " << pid << std::endl;
+                }
+                continue;
+            }
+            collect_results(&workers[k], &channels[k], &reorder_buffer, &sentences, &run.m_pos_stats_table);
+            int busy_sentence_index = channels[k].m_busy_sentence_index;
+            int status = event.m_status;
+            std::stringstream ss;
+            ss << "ERROR: Worker #" << k << " (pid " << pid << ") ";
+            if(WIFSIGNALED(status)) {
+                ss << "killed by signal " << WTERMSIG(status);
+            } else {
+                ss << "exited with status " << WEXITSTATUS(status);
+            }
+            std::deque<int> &outstanding = workers[k].m_outstanding;
+            for(std::deque<int>::reverse_iterator q = outstanding.rbegin(); q != outstanding.rend(); q++) {
+                if(*q == busy_sentence_index) {
+                    ss << " on sentence #" << *q;
+                    reorder_buffer[*q] = worker_result_t(false, "", ss.str() + "\n");
+                    sentences.erase(*q);
+                } else {
+                    resend.push_front(*q); // keeps them in input order
+                }
+            }
+            if(busy_sentence_index < 0 || !reorder_buffer.count(busy_sentence_index)) {
+                std::cerr << ss.str() << std::endl;
+            }
+            outstanding.clear();
+            workers[k].m_buffer.clear();
+            workers[k].m_pid       = 0;
+            workers[k].m_restarted = true;
+            start_worker(request_fd, channels, k);
+            restart_count++;
+        }
+        std::map<int, worker_result_t>::iterator r;
+        while((r = reorder_buffer.find(printed_count)) != reorder_buffer.end()) {
+            std::cout << (*r).second.m_out << std::flush;
+            std::cerr << (*r).second.m_err;
+            if((*r).second.m_success) {
+                parsed_sentence_count++;
+            }
+            reorder_buffer.erase(r);
+            printed_count++;
+        }
+        if(input_done && resend.empty() && printed_count == sentence_count) {
+            break;
+        }
+        if(idle) {
+            usleep(WORKER_POLL_US);
+        }
+    }
+    pthread_join(reader_thread, NULL);
+    for(size_t i = 0; i < worker_count; i++) {
+        push_task(&channels[i], -1, "");
+    }
+    close(request_fd); // the spawner reaps the workers, then exits
+    spawner_event_t event;
+    while(read_spawner_event(event_fd, &event, true)); // until the spawner and its workers are gone
+    close(event_fd);
+    waitpid(spawner_pid, NULL, 0);
+    munmap(shared, shared_size);
+    run.save_stats();
+    std::cerr << "Info: " << parsed_sentence_count << "/" << sentence_count << " sentences parsed" << std::endl;
+    if(restart_count) {
+        std::cerr << "Info: Restarted " << restart_count << " worker(s)" << std::endl;
+    }
+    return parsed_sentence_count != 0;
+}
+
+bool apply_options(options_t &options, xl::MemBudget* process_mem_budget)
+{
+    if(options.mode == options_t::MODE_HELP) {
+        display_usage(true);
+        return true;
+    }
+    if(options.stream) {
+        return apply_stream(options, process_mem_budget);
+    }
+    if(options.process_mode) {
+        return apply_workers(options);
+    }
+    if(!options.corpus_filename.empty()) {
+        return apply_corpus(options, process_mem_budget);
+    }
+    if(options.expr.empty()) {
+        if(!options.quiet) {
+            std::cerr << "ERROR: mode not supported!" << std::endl;
+        }
+        return false;
+    }
+    run_context_t run(&options, process_mem_budget);
+    bool result = false;
+    {
+        sentence_context_t sc(&run, options.expr);
+        tag_sentence(&sc);
+        sc.flush_log(std::cerr);
+        enumerate_paths(&sc);
+        sc.flush_log(std::cerr);
+        parse_paths(&sc);
+        result = print_sentence(&sc, std::cout, std::cerr);
+    }
+    run.save_stats();
+    return result;
+}
+
 int main(int argc, char** argv)
 {
     options_t options;
@@ -1404,7 +3062,8 @@ int main(int argc, char** argv)
         display_usage(false);
         return EXIT_FAILURE;
     }
-    if(!apply_options(options)) {
+    xl::MemBudget process_mem_budget(options.process_mem_budget);
+    if(!apply_options(options, &process_mem_budget)) {
         return EXIT_FAILURE;
     }
     return EXIT_SUCCESS;
@@ -38,6 +38,7 @@
 
 #define MAKE_TERM(lexer_id, ...)   xl::mvc::MVCModel::make_term(tree_context(), lexer_id, ##__VA_ARGS__)
 #define MAKE_SYMBOL(...)           xl::mvc::MVCModel::make_symbol(tree_context(), ##__VA_ARGS__)
+#define APPEND_SYMBOL(...)         xl::mvc::MVCModel::append_symbol(tree_context(), ##__VA_ARGS__)
 #define ERROR_LEXER_ID_NOT_FOUND   "missing lexer id handler, most likely you forgot to register one"
 #define ERROR_LEXER_NAME_NOT_FOUND "missing lexer name handler, most likely you forgot to register one"
 
@@ -270,130 +271,130 @@ root:
     ;
 
 S_PUNC:
-      S     PUNC { $$ = MAKE_SYMBOL(ID_S_PUNC, 2, $1, $2); }
-    | S EOS PUNC { $$ = MAKE_SYMBOL(ID_S_PUNC, 3, $1, $2, $3); }
+      S     PUNC { $$ = MAKE_SYMBOL(ID_S_PUNC, $1, $2); }
+    | S EOS PUNC { $$ = MAKE_SYMBOL(ID_S_PUNC, $1, $2, $3); }
     ;
 
 S:
-      STMT  { $$ = MAKE_SYMBOL(ID_S, 1, $1); }
-    | QUERY { $$ = MAKE_SYMBOL(ID_S, 1, $1); }
-    | COND  { $$ = MAKE_SYMBOL(ID_S, 1, $1); }
-    | CMD   { $$ = MAKE_SYMBOL(ID_S, 1, $1); }
+      STMT  { $$ = MAKE_SYMBOL(ID_S, $1); }
+    | QUERY { $$ = MAKE_SYMBOL(ID_S, $1); }
+    | COND  { $$ = MAKE_SYMBOL(ID_S, $1); }
+    | CMD   { $$ = MAKE_SYMBOL(ID_S, $1); }
     ;
 
 STMT:
-      CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_STMT, 1, $1); }
+      CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_STMT, $1); }
     ;
 
 QUERY:
-      QCLAUSE_LIST { $$ = MAKE_SYMBOL(ID_QUERY, 1, $1); }
+      QCLAUSE_LIST { $$ = MAKE_SYMBOL(ID_QUERY, $1); }
     ;
 
 COND:
-      IF      CLAUSE_LIST THEN        CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_COND, 2, $2, $4); }
-    |         CLAUSE_LIST IF          CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_COND, 2, $1, $3); }
-    | BECAUSE CLAUSE_LIST CONJ_CLAUSE CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_COND, 2, $2, $4); }
-    |         CLAUSE_LIST BECAUSE     CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_COND, 2, $1, $3); }
-    |         AUX_NP_V    CONJ_CLAUSE CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_COND, 2, $1, $3); }
+      IF      CLAUSE_LIST THEN        CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_COND, $2, $4); }
+    |         CLAUSE_LIST IF          CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_COND, $1, $3); }
+    | BECAUSE CLAUSE_LIST CONJ_CLAUSE CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_COND, $2, $4); }
+    |         CLAUSE_LIST BECAUSE     CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_COND, $1, $3); }
+    |         AUX_NP_V    CONJ_CLAUSE CLAUSE_LIST { $$ = MAKE_SYMBOL(ID_COND, $1, $3); }
     ;
 
 CMD:
-      CVP_LIST { $$ = MAKE_SYMBOL(ID_CMD, 1, $1); }
+      CVP_LIST { $$ = MAKE_SYMBOL(ID_CMD, $1); }
     ;
 
 CLAUSE:
-      NP_LIST VP_LIST { $$ = MAKE_SYMBOL(ID_CLAUSE, 2, $1, $2); }
-    | PREP_LIST       { $$ = MAKE_SYMBOL(ID_CLAUSE, 1, $1); }
+      NP_LIST VP_LIST { $$ = MAKE_SYMBOL(ID_CLAUSE, $1, $2); }
+    | PREP_LIST       { $$ = MAKE_SYMBOL(ID_CLAUSE, $1); }
     ;
 
 QCLAUSE:
-             QVP { $$ = MAKE_SYMBOL(ID_QCLAUSE, 1, $1); }
-    | WHWORD QVP { $$ = MAKE_SYMBOL(ID_QCLAUSE, 2, $1, $2); }
+             QVP { $$ = MAKE_SYMBOL(ID_QCLAUSE, $1); }
+    | WHWORD QVP { $$ = MAKE_SYMBOL(ID_QCLAUSE, $1, $2); }
     ;
 
 //=============================================================================
 // NOUN PART -- VERB PART
 
 NP:
-      POSS           { $$ = MAKE_SYMBOL(ID_NP, 1, $1); }
-    | ADV_VGERUND_NP { $$ = MAKE_SYMBOL(ID_NP, 1, $1); }
-    | INFIN          { $$ = MAKE_SYMBOL(ID_NP, 1, $1); }
-    | WHPRON VP      { $$ = MAKE_SYMBOL(ID_NP, 2, $1, $2); }
-    | PREP_LIST      { $$ = MAKE_SYMBOL(ID_NP, 1, $1); }
+      POSS           { $$ = MAKE_SYMBOL(ID_NP, $1); }
+    | ADV_VGERUND_NP { $$ = MAKE_SYMBOL(ID_NP, $1); }
+    | INFIN          { $$ = MAKE_SYMBOL(ID_NP, $1); }
+    | WHPRON VP      { $$ = MAKE_SYMBOL(ID_NP, $1, $2); }
+    | PREP_LIST      { $$ = MAKE_SYMBOL(ID_NP, $1); }
     ;
 
 POSS:
-      DET_ADJ_N                      { $$ = MAKE_SYMBOL(ID_POSS, 1, $1); }
-    | DET_ADJ_N SUFFIXPOSS POSS_LIST { $$ = MAKE_SYMBOL(ID_POSS, 3, $1, $2, $3); }
-    |                      POSS_LIST { $$ = MAKE_SYMBOL(ID_POSS, 1, $1); }
+      DET_ADJ_N                      { $$ = MAKE_SYMBOL(ID_POSS, $1); }
+    | DET_ADJ_N SUFFIXPOSS POSS_LIST { $$ = MAKE_SYMBOL(ID_POSS, $1, $2, $3); }
+    |                      POSS_LIST { $$ = MAKE_SYMBOL(ID_POSS, $1); }
     ;
 
 VP:
-        AUX_NOT_V                      { $$ = MAKE_SYMBOL(ID_VP, 1, $1); }
-    | MODAL_NOT_OR_FREQ   MODAL_TARGET { $$ = MAKE_SYMBOL(ID_VP, 2, $1, $2); }
-    |    DO_NOT_OR_FREQ      DO_TARGET { $$ = MAKE_SYMBOL(ID_VP, 2, $1, $2); }
-    |                   FREQ_DO_TARGET { $$ = MAKE_SYMBOL(ID_VP, 1, $1); }
-    |                     ADV_VPAST_NP { $$ = MAKE_SYMBOL(ID_VP, 1, $1); }
+        AUX_NOT_V                      { $$ = MAKE_SYMBOL(ID_VP, $1); }
+    | MODAL_NOT_OR_FREQ   MODAL_TARGET { $$ = MAKE_SYMBOL(ID_VP, $1, $2); }
+    |    DO_NOT_OR_FREQ      DO_TARGET { $$ = MAKE_SYMBOL(ID_VP, $1, $2); }
+    |                   FREQ_DO_TARGET { $$ = MAKE_SYMBOL(ID_VP, $1); }
+    |                     ADV_VPAST_NP { $$ = MAKE_SYMBOL(ID_VP, $1); }
     ;
 
 QVP:
-        AUX_NP_V              { $$ = MAKE_SYMBOL(ID_QVP, 1, $1); }
-    | MODAL_NP   MODAL_TARGET { $$ = MAKE_SYMBOL(ID_QVP, 2, $1, $2); }
-    |    DO_NP      DO_TARGET { $$ = MAKE_SYMBOL(ID_QVP, 2, $1, $2); }
+        AUX_NP_V              { $$ = MAKE_SYMBOL(ID_QVP, $1); }
+    | MODAL_NP   MODAL_TARGET { $$ = MAKE_SYMBOL(ID_QVP, $1, $2); }
+    |    DO_NP      DO_TARGET { $$ = MAKE_SYMBOL(ID_QVP, $1, $2); }
     ;
 
 CVP:
-      CAUX_V                        { $$ = MAKE_SYMBOL(ID_CVP, 1, $1); }
-    | DO_NOT_OR_FREQ      DO_TARGET { $$ = MAKE_SYMBOL(ID_CVP, 2, $1, $2); }
-    |                FREQ_DO_TARGET { $$ = MAKE_SYMBOL(ID_CVP, 1, $1); }
+      CAUX_V                        { $$ = MAKE_SYMBOL(ID_CVP, $1); }
+    | DO_NOT_OR_FREQ      DO_TARGET { $$ = MAKE_SYMBOL(ID_CVP, $1, $2); }
+    |                FREQ_DO_TARGET { $$ = MAKE_SYMBOL(ID_CVP, $1); }
     ;
 
 //=============================================================================
 // AUXILIARY VERB
 
 AUX_V:
-           BE     OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_V, 2, $1, $2); }
-    | HAVE BEEN   OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_V, 3, $1, $2, $3); }
-    | HAVE      ADV_HAVE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_V, 2, $1, $2); }
+           BE     OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_V, $1, $2); }
+    | HAVE BEEN   OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_V, $1, $2, $3); }
+    | HAVE      ADV_HAVE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_V, $1, $2); }
     ;
 
 CAUX_V:
-      CBE OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_CAUX_V, 2, $1, $2); }
+      CBE OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_CAUX_V, $1, $2); }
     ;
 
 AUX_NOT_V:
-                       BE_NOT_OR_FREQ   OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NOT_V, 2, $1, $2); }
-    | HAVE_NOT_OR_FREQ BEEN             OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NOT_V, 3, $1, $2, $3); }
-    | HAVE_NOT_OR_FREQ                ADV_HAVE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NOT_V, 2, $1, $2); }
+                       BE_NOT_OR_FREQ   OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NOT_V, $1, $2); }
+    | HAVE_NOT_OR_FREQ BEEN             OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NOT_V, $1, $2, $3); }
+    | HAVE_NOT_OR_FREQ                ADV_HAVE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NOT_V, $1, $2); }
     ;
 
 AUX_NP_V:
-              BE_NP   OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NP_V, 2, $1, $2); }
-    | HAVE_NP BEEN    OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NP_V, 3, $1, $2, $3); }
-    | HAVE_NP       ADV_HAVE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NP_V, 2, $1, $2); }
+              BE_NP   OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NP_V, $1, $2); }
+    | HAVE_NP BEEN    OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NP_V, $1, $2, $3); }
+    | HAVE_NP       ADV_HAVE_TARGET { $$ = MAKE_SYMBOL(ID_AUX_NP_V, $1, $2); }
     ;
 
 //=============================================================================
 // VERB
 
 V_NP:
-      V         { $$ = MAKE_SYMBOL(ID_V_NP, 1, $1); }
-    | V NP_LIST { $$ = MAKE_SYMBOL(ID_V_NP, 2, $1, $2); }
+      V         { $$ = MAKE_SYMBOL(ID_V_NP, $1); }
+    | V NP_LIST { $$ = MAKE_SYMBOL(ID_V_NP, $1, $2); }
     ;
 
 VPAST_NP:
-      VPAST         { $$ = MAKE_SYMBOL(ID_VPAST_NP, 1, $1); }
-    | VPAST NP_LIST { $$ = MAKE_SYMBOL(ID_VPAST_NP, 2, $1, $2); }
+      VPAST         { $$ = MAKE_SYMBOL(ID_VPAST_NP, $1); }
+    | VPAST NP_LIST { $$ = MAKE_SYMBOL(ID_VPAST_NP, $1, $2); }
     ;
 
 VGERUND_NP:
-      VGERUND               { $$ = MAKE_SYMBOL(ID_VGERUND_NP, 1, $1); }
-    | VGERUND NP_LIST       { $$ = MAKE_SYMBOL(ID_VGERUND_NP, 2, $1, $2); }
-    | BEING   OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_VGERUND_NP, 2, $1, $2); }
+      VGERUND               { $$ = MAKE_SYMBOL(ID_VGERUND_NP, $1); }
+    | VGERUND NP_LIST       { $$ = MAKE_SYMBOL(ID_VGERUND_NP, $1, $2); }
+    | BEING   OPT_BE_TARGET { $$ = MAKE_SYMBOL(ID_VGERUND_NP, $1, $2); }
     ;
 
 PREP_NP:
-      PREP NP_LIST { $$ = MAKE_SYMBOL(ID_PREP_NP, 2, $1, $2); } // NOTE: using NP_LIST here causes shift-reduce conflict because NP ==> PREP_NP ==> NP
+      PREP NP_LIST { $$ = MAKE_SYMBOL(ID_PREP_NP, $1, $2); } // NOTE: using NP_LIST here causes shift-reduce conflict because NP ==> PREP_NP ==> NP
                                                                 //       however, not having NP_LIST here makes parsing "from here and there.." impossible
     ;
 
@@ -401,268 +402,268 @@ PREP_NP:
 // TARGET (BE -- HAVE -- MODAL -- DO)
 
 BE_TARGET:
-      ADV_HAVE_TARGET { $$ = MAKE_SYMBOL(ID_BE_TARGET, 1, $1); }
-    | NP_LIST         { $$ = MAKE_SYMBOL(ID_BE_TARGET, 1, $1); }
-    | ADJ_LIST        { $$ = MAKE_SYMBOL(ID_BE_TARGET, 1, $1); }
+      ADV_HAVE_TARGET { $$ = MAKE_SYMBOL(ID_BE_TARGET, $1); }
+    | NP_LIST         { $$ = MAKE_SYMBOL(ID_BE_TARGET, $1); }
+    | ADJ_LIST        { $$ = MAKE_SYMBOL(ID_BE_TARGET, $1); }
     ;
 
 HAVE_TARGET:
-      VPASTPERF         { $$ = MAKE_SYMBOL(ID_HAVE_TARGET, 1, $1); }
-    | VPASTPERF NP_LIST { $$ = MAKE_SYMBOL(ID_HAVE_TARGET, 2, $1, $2); }
+      VPASTPERF         { $$ = MAKE_SYMBOL(ID_HAVE_TARGET, $1); }
+    | VPASTPERF NP_LIST { $$ = MAKE_SYMBOL(ID_HAVE_TARGET, $1, $2); }
     ;
 
 MODAL_TARGET:
-      DO_TARGET { $$ = MAKE_SYMBOL(ID_MODAL_TARGET, 1, $1); }
-    | AUX_V     { $$ = MAKE_SYMBOL(ID_MODAL_TARGET, 1, $1); }
+      DO_TARGET { $$ = MAKE_SYMBOL(ID_MODAL_TARGET, $1); }
+    | AUX_V     { $$ = MAKE_SYMBOL(ID_MODAL_TARGET, $1); }
     ;
 
 DO_TARGET:
-      ADV_V_NP { $$ = MAKE_SYMBOL(ID_DO_TARGET, 1, $1); }
-    | V_INFIN  { $$ = MAKE_SYMBOL(ID_DO_TARGET, 1, $1); }
+      ADV_V_NP { $$ = MAKE_SYMBOL(ID_DO_TARGET, $1); }
+    | V_INFIN  { $$ = MAKE_SYMBOL(ID_DO_TARGET, $1); }
     ;
 
 OPT_BE_TARGET:
       /* empty */ { $$ = xl::node::SymbolNode::eol(); }
-    | BE_TARGET   { $$ = MAKE_SYMBOL(ID_OPT_BE_TARGET, 1, $1); }
+    | BE_TARGET   { $$ = MAKE_SYMBOL(ID_OPT_BE_TARGET, $1); }
     ;
 
 FREQ_DO_TARGET:
-           DO_TARGET { $$ = MAKE_SYMBOL(ID_FREQ_DO_TARGET, 1, $1); }
-    | FREQ DO_TARGET { $$ = MAKE_SYMBOL(ID_FREQ_DO_TARGET, 2, $1, $2); }
+           DO_TARGET { $$ = MAKE_SYMBOL(ID_FREQ_DO_TARGET, $1); }
+    | FREQ DO_TARGET { $$ = MAKE_SYMBOL(ID_FREQ_DO_TARGET, $1, $2); }
     ;
 
 //=============================================================================
 // VERB (ADVERB)
 
 ADV_V_NP:
-                V_NP           { $$ = MAKE_SYMBOL(ID_ADV_V_NP, 1, $1); }
-    | ADV_MOD_V V_NP           { $$ = MAKE_SYMBOL(ID_ADV_V_NP, 2, $1, $2); }
-    |           V_NP ADV_MOD_V { $$ = MAKE_SYMBOL(ID_ADV_V_NP, 2, $1, $2); }
+                V_NP           { $$ = MAKE_SYMBOL(ID_ADV_V_NP, $1); }
+    | ADV_MOD_V V_NP           { $$ = MAKE_SYMBOL(ID_ADV_V_NP, $1, $2); }
+    |           V_NP ADV_MOD_V { $$ = MAKE_SYMBOL(ID_ADV_V_NP, $1, $2); }
     ;
 
 ADV_VPAST_NP:
-                VPAST_NP           { $$ = MAKE_SYMBOL(ID_ADV_VPAST_NP, 1, $1); }
-    | ADV_MOD_V VPAST_NP           { $$ = MAKE_SYMBOL(ID_ADV_VPAST_NP, 2, $1, $2); }
-    |           VPAST_NP ADV_MOD_V { $$ = MAKE_SYMBOL(ID_ADV_VPAST_NP, 2, $1, $2); }
+                VPAST_NP           { $$ = MAKE_SYMBOL(ID_ADV_VPAST_NP, $1); }
+    | ADV_MOD_V VPAST_NP           { $$ = MAKE_SYMBOL(ID_ADV_VPAST_NP, $1, $2); }
+    |           VPAST_NP ADV_MOD_V { $$ = MAKE_SYMBOL(ID_ADV_VPAST_NP, $1, $2); }
     ;
 
 ADV_VGERUND_NP:
-                          VGERUND_NP                      { $$ = MAKE_SYMBOL(ID_ADV_VGERUND_NP, 1, $1); }
-    | ADV_MOD_VGERUND_PRE VGERUND_NP                      { $$ = MAKE_SYMBOL(ID_ADV_VGERUND_NP, 2, $1, $2); }
-    |                     VGERUND_NP ADV_MOD_VGERUND_POST { $$ = MAKE_SYMBOL(ID_ADV_VGERUND_NP, 2, $1, $2); }
+                          VGERUND_NP                      { $$ = MAKE_SYMBOL(ID_ADV_VGERUND_NP, $1); }
+    | ADV_MOD_VGERUND_PRE VGERUND_NP                      { $$ = MAKE_SYMBOL(ID_ADV_VGERUND_NP, $1, $2); }
+    |                     VGERUND_NP ADV_MOD_VGERUND_POST { $$ = MAKE_SYMBOL(ID_ADV_VGERUND_NP, $1, $2); }
     ;
 
 ADV_HAVE_TARGET:
-                HAVE_TARGET           { $$ = MAKE_SYMBOL(ID_ADV_HAVE_TARGET, 1, $1); }
-    | ADV_MOD_V HAVE_TARGET           { $$ = MAKE_SYMBOL(ID_ADV_HAVE_TARGET, 2, $1, $2); }
-    |           HAVE_TARGET ADV_MOD_V { $$ = MAKE_SYMBOL(ID_ADV_HAVE_TARGET, 2, $1, $2); }
+                HAVE_TARGET           { $$ = MAKE_SYMBOL(ID_ADV_HAVE_TARGET, $1); }
+    | ADV_MOD_V HAVE_TARGET           { $$ = MAKE_SYMBOL(ID_ADV_HAVE_TARGET, $1, $2); }
+    |           HAVE_TARGET ADV_MOD_V { $$ = MAKE_SYMBOL(ID_ADV_HAVE_TARGET, $1, $2); }
     ;
 
 //=============================================================================
 // INFINITIVE
 
 INFIN:
-      TO_NOT_OR_FREQ MODAL_TARGET { $$ = MAKE_SYMBOL(ID_INFIN, 2, $1, $2); }
+      TO_NOT_OR_FREQ MODAL_TARGET { $$ = MAKE_SYMBOL(ID_INFIN, $1, $2); }
     ;
 
 V_INFIN:
-      V_MOD_INFIN INFIN { $$ = MAKE_SYMBOL(ID_V_INFIN, 2, $1, $2); }
+      V_MOD_INFIN INFIN { $$ = MAKE_SYMBOL(ID_V_INFIN, $1, $2); }
     ;
 
 //=============================================================================
 // ADJECTIVE -- ADVERB
 
 ADJ_N:
-               N { $$ = MAKE_SYMBOL(ID_ADJ_N, 1, $1); }
-    | ADJ_LIST N { $$ = MAKE_SYMBOL(ID_ADJ_N, 2, $1, $2); }
+               N { $$ = MAKE_SYMBOL(ID_ADJ_N, $1); }
+    | ADJ_LIST N { $$ = MAKE_SYMBOL(ID_ADJ_N, $1, $2); }
     ;
 
 ADV_ADJ:
-                  ADJ { $$ = MAKE_SYMBOL(ID_ADV_ADJ, 1, $1); }
-    | ADV_MOD_ADJ ADJ { $$ = MAKE_SYMBOL(ID_ADV_ADJ, 2, $1, $2); }
+                  ADJ { $$ = MAKE_SYMBOL(ID_ADV_ADJ, $1); }
+    | ADV_MOD_ADJ ADJ { $$ = MAKE_SYMBOL(ID_ADV_ADJ, $1, $2); }
     ;
 
 //=============================================================================
 // DEMONSTRATIVE -- ARTICLE/PREFIX-POSSESSIVE
 
 DET_ADJ_N:
-      DEM                     { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, 1, $1); }
-    | DEM               ADJ_N { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, 2, $1, $2); }
-    | ART_OR_PREFIXPOSS ADJ_N { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, 2, $1, $2); }
+      DEM                     { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, $1); }
+    | DEM               ADJ_N { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, $1, $2); }
+    | ART_OR_PREFIXPOSS ADJ_N { $$ = MAKE_SYMBOL(ID_DET_ADJ_N, $1, $2); }
     ;
 
 //=============================================================================
 // BE -- HAVE -- MODAL -- DO (NOT)
 
 BE_NOT:
-      BE     { $$ = MAKE_SYMBOL(ID_BE_NOT, 1, $1); }
-    | BE NOT { $$ = MAKE_SYMBOL(ID_BE_NOT, 2, $1, $2); }
+      BE     { $$ = MAKE_SYMBOL(ID_BE_NOT, $1); }
+    | BE NOT { $$ = MAKE_SYMBOL(ID_BE_NOT, $1, $2); }
     ;
 
 HAVE_NOT:
-      HAVE     { $$ = MAKE_SYMBOL(ID_HAVE_NOT, 1, $1); }
-    | HAVE NOT { $$ = MAKE_SYMBOL(ID_HAVE_NOT, 2, $1, $2); }
+      HAVE     { $$ = MAKE_SYMBOL(ID_HAVE_NOT, $1); }
+    | HAVE NOT { $$ = MAKE_SYMBOL(ID_HAVE_NOT, $1, $2); }
     ;
 
 MODAL_NOT:
-      MODAL     { $$ = MAKE_SYMBOL(ID_MODAL_NOT, 1, $1); }
-    | MODAL NOT { $$ = MAKE_SYMBOL(ID_MODAL_NOT, 2, $1, $2); }
+      MODAL     { $$ = MAKE_SYMBOL(ID_MODAL_NOT, $1); }
+    | MODAL NOT { $$ = MAKE_SYMBOL(ID_MODAL_NOT, $1, $2); }
     ;
 
 DO_NOT:
-      DO     { $$ = MAKE_SYMBOL(ID_DO_NOT, 1, $1); }
-    | DO NOT { $$ = MAKE_SYMBOL(ID_DO_NOT, 2, $1, $2); }
+      DO     { $$ = MAKE_SYMBOL(ID_DO_NOT, $1); }
+    | DO NOT { $$ = MAKE_SYMBOL(ID_DO_NOT, $1, $2); }
     ;
 
 //=============================================================================
 // BE -- HAVE -- MODAL -- DO (NOT NOUN FREQ)
 
 BE_NP:
-      BE_NOT NP_LIST      { $$ = MAKE_SYMBOL(ID_BE_NP, 2, $1, $2); }
-    | BE_NOT NP_LIST FREQ { $$ = MAKE_SYMBOL(ID_BE_NP, 3, $1, $2, $3); }
+      BE_NOT NP_LIST      { $$ = MAKE_SYMBOL(ID_BE_NP, $1, $2); }
+    | BE_NOT NP_LIST FREQ { $$ = MAKE_SYMBOL(ID_BE_NP, $1, $2, $3); }
     ;
 
 HAVE_NP:
-      HAVE_NOT NP_LIST      { $$ = MAKE_SYMBOL(ID_HAVE_NP, 2, $1, $2); }
-    | HAVE_NOT NP_LIST FREQ { $$ = MAKE_SYMBOL(ID_HAVE_NP, 3, $1, $2, $3); }
+      HAVE_NOT NP_LIST      { $$ = MAKE_SYMBOL(ID_HAVE_NP, $1, $2); }
+    | HAVE_NOT NP_LIST FREQ { $$ = MAKE_SYMBOL(ID_HAVE_NP, $1, $2, $3); }
     ;
 
 MODAL_NP:
-      MODAL_NOT NP_LIST      { $$ = MAKE_SYMBOL(ID_MODAL_NP, 2, $1, $2); }
-    | MODAL_NOT NP_LIST FREQ { $$ = MAKE_SYMBOL(ID_MODAL_NP, 3, $1, $2, $3); }
+      MODAL_NOT NP_LIST      { $$ = MAKE_SYMBOL(ID_MODAL_NP, $1, $2); }
+    | MODAL_NOT NP_LIST FREQ { $$ = MAKE_SYMBOL(ID_MODAL_NP, $1, $2, $3); }
     ;
 
 DO_NP:
-      DO_NOT NP_LIST      { $$ = MAKE_SYMBOL(ID_DO_NP, 2, $1, $2); }
-    | DO_NOT NP_LIST FREQ { $$ = MAKE_SYMBOL(ID_DO_NP, 3, $1, $2, $3); }
+      DO_NOT NP_LIST      { $$ = MAKE_SYMBOL(ID_DO_NP, $1, $2); }
+    | DO_NOT NP_LIST FREQ { $$ = MAKE_SYMBOL(ID_DO_NP, $1, $2, $3); }
     ;
 
 //=============================================================================
 // BE -- HAVE -- MODAL -- DO -- TO (NOT OR FREQ)
 
 BE_NOT_OR_FREQ:
-      BE             { $$ = MAKE_SYMBOL(ID_BE_NOT_OR_FREQ, 1, $1); }
-    | BE NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_BE_NOT_OR_FREQ, 2, $1, $2); }
+      BE             { $$ = MAKE_SYMBOL(ID_BE_NOT_OR_FREQ, $1); }
+    | BE NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_BE_NOT_OR_FREQ, $1, $2); }
     ;
 
 HAVE_NOT_OR_FREQ:
-      HAVE             { $$ = MAKE_SYMBOL(ID_HAVE_NOT_OR_FREQ, 1, $1); }
-    | HAVE NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_HAVE_NOT_OR_FREQ, 2, $1, $2); }
+      HAVE             { $$ = MAKE_SYMBOL(ID_HAVE_NOT_OR_FREQ, $1); }
+    | HAVE NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_HAVE_NOT_OR_FREQ, $1, $2); }
     ;
 
 MODAL_NOT_OR_FREQ:
-      MODAL             { $$ = MAKE_SYMBOL(ID_MODAL_NOT_OR_FREQ, 1, $1); }
-    | MODAL NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_MODAL_NOT_OR_FREQ, 2, $1, $2); }
+      MODAL             { $$ = MAKE_SYMBOL(ID_MODAL_NOT_OR_FREQ, $1); }
+    | MODAL NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_MODAL_NOT_OR_FREQ, $1, $2); }
     ;
 
 DO_NOT_OR_FREQ:
-      DO             { $$ = MAKE_SYMBOL(ID_DO_NOT_OR_FREQ, 1, $1); }
-    | DO NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_DO_NOT_OR_FREQ, 2, $1, $2); }
+      DO             { $$ = MAKE_SYMBOL(ID_DO_NOT_OR_FREQ, $1); }
+    | DO NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_DO_NOT_OR_FREQ, $1, $2); }
     ;
 
 TO_NOT_OR_FREQ:
-      TO_MOD_V             { $$ = MAKE_SYMBOL(ID_TO_NOT_OR_FREQ, 1, $1); }
-    | TO_MOD_V NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_TO_NOT_OR_FREQ, 2, $1, $2); }
+      TO_MOD_V             { $$ = MAKE_SYMBOL(ID_TO_NOT_OR_FREQ, $1); }
+    | TO_MOD_V NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_TO_NOT_OR_FREQ, $1, $2); }
     ;
 
 //=============================================================================
 // LIST
 
 S_LIST:
-             S_PUNC { $$ = MAKE_SYMBOL(ID_S_LIST, 1, $1); }
-    | S_LIST S_PUNC { $$ = MAKE_SYMBOL(ID_S_LIST, 2, $1, $2); }
+             S_PUNC { $$ = MAKE_SYMBOL(ID_S_LIST, $1); }
+    | S_LIST S_PUNC { $$ = APPEND_SYMBOL(ID_S_LIST, $1, $2); }
     ;
 
 CLAUSE_LIST:
-                              CLAUSE { $$ = MAKE_SYMBOL(ID_CLAUSE_LIST, 1, $1); }
-    | CLAUSE_LIST             CLAUSE { $$ = MAKE_SYMBOL(ID_CLAUSE_LIST, 2, $1, $2); }
-    | CLAUSE_LIST CONJ_CLAUSE CLAUSE { $$ = MAKE_SYMBOL(ID_CLAUSE_LIST, 3, $1, $2, $3); }
+                              CLAUSE { $$ = MAKE_SYMBOL(ID_CLAUSE_LIST, $1); }
+    | CLAUSE_LIST             CLAUSE { $$ = APPEND_SYMBOL(ID_CLAUSE_LIST, $1, $2); }
+    | CLAUSE_LIST CONJ_CLAUSE CLAUSE { $$ = APPEND_SYMBOL(ID_CLAUSE_LIST, $1, $2, $3); }
     ;
 
 QCLAUSE_LIST:
-                               QCLAUSE { $$ = MAKE_SYMBOL(ID_QCLAUSE_LIST, 1, $1); }
-    | QCLAUSE_LIST             QCLAUSE { $$ = MAKE_SYMBOL(ID_QCLAUSE_LIST, 2, $1, $2); }
-    | QCLAUSE_LIST CONJ_CLAUSE QCLAUSE { $$ = MAKE_SYMBOL(ID_QCLAUSE_LIST, 3, $1, $2, $3); }
+                               QCLAUSE { $$ = MAKE_SYMBOL(ID_QCLAUSE_LIST, $1); }
+    | QCLAUSE_LIST             QCLAUSE { $$ = APPEND_SYMBOL(ID_QCLAUSE_LIST, $1, $2); }
+    | QCLAUSE_LIST CONJ_CLAUSE QCLAUSE { $$ = APPEND_SYMBOL(ID_QCLAUSE_LIST, $1, $2, $3); }
     ;
 
 CVP_LIST:
-                           CVP { $$ = MAKE_SYMBOL(ID_CVP_LIST, 1, $1); }
-    | CVP_LIST             CVP { $$ = MAKE_SYMBOL(ID_CVP_LIST, 2, $1, $2); }
-    | CVP_LIST CONJ_CLAUSE CVP { $$ = MAKE_SYMBOL(ID_CVP_LIST, 3, $1, $2, $3); }
+                           CVP { $$ = MAKE_SYMBOL(ID_CVP_LIST, $1); }
+    | CVP_LIST             CVP { $$ = APPEND_SYMBOL(ID_CVP_LIST, $1, $2); }
+    | CVP_LIST CONJ_CLAUSE CVP { $$ = APPEND_SYMBOL(ID_CVP_LIST, $1, $2, $3); }
     ;
 
 NP_LIST:
-                          NP { $$ = MAKE_SYMBOL(ID_NP_LIST, 1, $1); }
-    | NP_LIST             NP { $$ = MAKE_SYMBOL(ID_NP_LIST, 2, $1, $2); }
-    | NP_LIST CONJ_NP_NOT NP { $$ = MAKE_SYMBOL(ID_NP_LIST, 3, $1, $2, $3); }
+                          NP { $$ = MAKE_SYMBOL(ID_NP_LIST, $1); }
+    | NP_LIST             NP { $$ = APPEND_SYMBOL(ID_NP_LIST, $1, $2); }
+    | NP_LIST CONJ_NP_NOT NP { $$ = APPEND_SYMBOL(ID_NP_LIST, $1, $2, $3); }
     ;
 
 VP_LIST:
-                          VP { $$ = MAKE_SYMBOL(ID_VP_LIST, 1, $1); }
-    | VP_LIST             VP { $$ = MAKE_SYMBOL(ID_VP_LIST, 2, $1, $2); }
-    | VP_LIST CONJ_VP_NOT VP { $$ = MAKE_SYMBOL(ID_VP_LIST, 3, $1, $2, $3); }
+                          VP { $$ = MAKE_SYMBOL(ID_VP_LIST, $1); }
+    | VP_LIST             VP { $$ = APPEND_SYMBOL(ID_VP_LIST, $1, $2); }
+    | VP_LIST CONJ_VP_NOT VP { $$ = APPEND_SYMBOL(ID_VP_LIST, $1, $2, $3); }
     ;
 
 ADJ_LIST:
-                            ADV_ADJ { $$ = MAKE_SYMBOL(ID_ADJ_LIST, 1, $1); }
-    | ADJ_LIST              ADV_ADJ { $$ = MAKE_SYMBOL(ID_ADJ_LIST, 2, $1, $2); }
-    | ADJ_LIST CONJ_ADJ_NOT ADV_ADJ { $$ = MAKE_SYMBOL(ID_ADJ_LIST, 3, $1, $2, $3); }
+                            ADV_ADJ { $$ = MAKE_SYMBOL(ID_ADJ_LIST, $1); }
+    | ADJ_LIST              ADV_ADJ { $$ = APPEND_SYMBOL(ID_ADJ_LIST, $1, $2); }
+    | ADJ_LIST CONJ_ADJ_NOT ADV_ADJ { $$ = APPEND_SYMBOL(ID_ADJ_LIST, $1, $2, $3); }
     ;
 
 PREP_LIST:
-                              PREP_NP { $$ = MAKE_SYMBOL(ID_PREP_LIST, 1, $1); }
-    | PREP_LIST               PREP_NP { $$ = MAKE_SYMBOL(ID_PREP_LIST, 2, $1, $2); }
-    | PREP_LIST CONJ_PREP_NOT PREP_NP { $$ = MAKE_SYMBOL(ID_PREP_LIST, 3, $1, $2, $3); }
+                              PREP_NP { $$ = MAKE_SYMBOL(ID_PREP_LIST, $1); }
+    | PREP_LIST               PREP_NP { $$ = APPEND_SYMBOL(ID_PREP_LIST, $1, $2); }
+    | PREP_LIST CONJ_PREP_NOT PREP_NP { $$ = APPEND_SYMBOL(ID_PREP_LIST, $1, $2, $3); }
     ;
 
 POSS_LIST:
-                           ADJ_N { $$ = MAKE_SYMBOL(ID_POSS_LIST, 1, $1); }
-    | POSS_LIST SUFFIXPOSS ADJ_N { $$ = MAKE_SYMBOL(ID_POSS_LIST, 3, $1, $2, $3); }
+                           ADJ_N { $$ = MAKE_SYMBOL(ID_POSS_LIST, $1); }
+    | POSS_LIST SUFFIXPOSS ADJ_N { $$ = APPEND_SYMBOL(ID_POSS_LIST, $1, $2, $3); }
     ;
 
 //=============================================================================
 // CONJUGATION
 
 CONJ_NP_NOT:
-      CONJ_NP             { $$ = MAKE_SYMBOL(ID_CONJ_NP_NOT, 1, $1); }
-    | CONJ_NP NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_CONJ_NP_NOT, 2, $1, $2); }
+      CONJ_NP             { $$ = MAKE_SYMBOL(ID_CONJ_NP_NOT, $1); }
+    | CONJ_NP NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_CONJ_NP_NOT, $1, $2); }
     ;
 
 CONJ_VP_NOT:
-      CONJ_VP             { $$ = MAKE_SYMBOL(ID_CONJ_VP_NOT, 1, $1); }
-    | CONJ_VP NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_CONJ_VP_NOT, 2, $1, $2); }
+      CONJ_VP             { $$ = MAKE_SYMBOL(ID_CONJ_VP_NOT, $1); }
+    | CONJ_VP NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_CONJ_VP_NOT, $1, $2); }
     ;
 
 CONJ_ADJ_NOT:
-      CONJ_ADJ             { $$ = MAKE_SYMBOL(ID_CONJ_ADJ_NOT, 1, $1); }
-    | CONJ_ADJ NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_CONJ_ADJ_NOT, 2, $1, $2); }
+      CONJ_ADJ             { $$ = MAKE_SYMBOL(ID_CONJ_ADJ_NOT, $1); }
+    | CONJ_ADJ NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_CONJ_ADJ_NOT, $1, $2); }
     ;
 
 CONJ_PREP_NOT:
-      CONJ_PREP             { $$ = MAKE_SYMBOL(ID_CONJ_PREP_NOT, 1, $1); }
-    | CONJ_PREP NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_CONJ_PREP_NOT, 2, $1, $2); }
+      CONJ_PREP             { $$ = MAKE_SYMBOL(ID_CONJ_PREP_NOT, $1); }
+    | CONJ_PREP NOT_OR_FREQ { $$ = MAKE_SYMBOL(ID_CONJ_PREP_NOT, $1, $2); }
     ;
 
 //=============================================================================
 // WH-PRONOUN
 
 WHPRON:
-      WHWORD          { $$ = MAKE_SYMBOL(ID_WHPRON, 1, $1); }
-    | WHWORD_MOD_THAT { $$ = MAKE_SYMBOL(ID_WHPRON, 1, $1); }
+      WHWORD          { $$ = MAKE_SYMBOL(ID_WHPRON, $1); }
+    | WHWORD_MOD_THAT { $$ = MAKE_SYMBOL(ID_WHPRON, $1); }
     ;
 
 //=============================================================================
  /* NOT-OR-FREQ -- EOS */
 
 NOT_OR_FREQ:
-      NOT      { $$ = MAKE_SYMBOL(ID_NOT_OR_FREQ, 1, $1); }
-    | NOT FREQ { $$ = MAKE_SYMBOL(ID_NOT_OR_FREQ, 2, $1, $2); }
-    |     FREQ { $$ = MAKE_SYMBOL(ID_NOT_OR_FREQ, 1, $1); }
+      NOT      { $$ = MAKE_SYMBOL(ID_NOT_OR_FREQ, $1); }
+    | NOT FREQ { $$ = MAKE_SYMBOL(ID_NOT_OR_FREQ, $1, $2); }
+    |     FREQ { $$ = MAKE_SYMBOL(ID_NOT_OR_FREQ, $1); }
     ;
 
 EOS:
-      TOO      { $$ = MAKE_SYMBOL(ID_EOS, 1, $1); }
-    | FREQ_EOS { $$ = MAKE_SYMBOL(ID_EOS, 1, $1); }
+      TOO      { $$ = MAKE_SYMBOL(ID_EOS, $1); }
+    | FREQ_EOS { $$ = MAKE_SYMBOL(ID_EOS, $1); }
     ;
 
 //=========
@@ -0,0 +1,83 @@
+// XLang
+// -- A minimum viable English parser implemented in LexYacc
+// Copyright (C) 2011 onlyuser <mailto:onlyuser@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// counts heap allocations made per lexed token by the libxl string/alloc paths
+
+#include "XLangAlloc.h" // Allocator
+#include "XLangTreeContext.h" // TreeContext
+#include "XLangString.h" // xl::replace
+#include <string> // std::string
+#include <vector> // std::vector
+#include <iostream> // std::cout
+#include <stdlib.h> // malloc
+#include <new> // std::bad_alloc
+
+static size_t alloc_count = 0;
+
+void* operator new(size_t size_bytes)
+{
+    alloc_count++;
+    void* ptr = malloc(size_bytes ? size_bytes : 1);
+    if(!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+struct token_t
+{
+    const std::string* m_value;
+    token_t(const std::string* value) : m_value(value) {}
+};
+
+int main(int argc, char** argv)
+{
+    const char* words[] = {"the", "quick", "brown", "fox", "jumps", "over", "the", "lazy", "dog"};
+    const char* tags[]  = {"D",   "ADJ",   "ADJ",   "N",   "V",     "PREP", "D",   "ADJ",  "N"};
+    const size_t word_count = sizeof(words)/sizeof(*words);
+    const size_t iterations = 10000;
+
+    // hoist everything not measured out of the loop
+    std::vector<std::string> word_vec(words, words+word_count);
+    std::vector<std::string> tag_vec(tags, tags+word_count);
+    const std::string find_string("'s");
+    const std::string replace_string(" 's");
+
+    size_t total_tokens = 0;
+    size_t total_allocs = 0;
+    for(size_t i = 0; i<iterations; i++) {
+        xl::Allocator alloc(__FILE__);
+        xl::TreeContext tc(alloc);
+        size_t start_count = alloc_count;
+        for(size_t j = 0; j<word_count; j++) {
+            std::string word = xl::replace(word_vec[j], find_string, replace_string);
+            std::string key = "{" + word + "}" + tag_vec[j];
+            new (PNEW(alloc, , token_t)) token_t(tc.alloc_unique_string(key));
+            total_tokens++;
+        }
+        total_allocs += alloc_count-start_count;
+    }
+    std::cout << "tokens: " << total_tokens << std::endl
+              << "allocations: " << total_allocs << std::endl
+              << "allocations per token: " << static_cast<double>(total_allocs)/total_tokens << std::endl;
+    return 0;
+}
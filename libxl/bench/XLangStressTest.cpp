@@ -0,0 +1,121 @@
+// XLang
+// -- A minimum viable English parser implemented in LexYacc
+// Copyright (C) 2011 onlyuser <mailto:onlyuser@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// renders the same trees from many threads at once and checks every copy
+// against a single-threaded render; `make stress` runs it under ThreadSanitizer
+
+#include "XLangAlloc.h" // Allocator
+#include "XLangTreeContext.h" // TreeContext
+#include "XLangSystem.h" // xl::system::get_execname
+#include "mvc/XLangMVCModel.h" // mvc::MVCModel
+#include "mvc/XLangMVCView.h" // mvc::MVCView
+#include "node/XLangNode.h" // node::SymbolNode
+#include <string> // std::string
+#include <vector> // std::vector
+#include <sstream> // std::stringstream
+#include <iostream> // std::cout
+#include <algorithm> // std::max
+#include <pthread.h> // pthread_t
+#include <stdlib.h> // EXIT_SUCCESS
+
+#define THREAD_COUNT 16
+#define TREE_COUNT   256 // rendered by every thread
+
+std::string id_to_name(uint32_t lexer_id)
+{
+    std::stringstream ss;
+    ss << "S" << lexer_id;
+    return ss.str();
+}
+
+// shape and size follow from seed; the bigger ones are wider than 200 columns
+static xl::node::NodeIdentIFace* make_tree(xl::TreeContext* tc, uint32_t seed, int depth)
+{
+    if(!depth) {
+        std::stringstream ss;
+        ss << "leaf" << seed % 1000;
+        xl::node::NodeIdentIFace* leaf = xl::mvc::MVCModel::make_term(tc, 1, tc->alloc_unique_string(ss.str()));
+        return (seed % 5) ? leaf : xl::mvc::MVCModel::make_symbol(tc, 2, leaf, xl::node::SymbolNode::eol());
+    }
+    std::vector<xl::node::NodeIdentIFace*> children;
+    for(uint32_t i = 0; i < 1 + seed % 3; i++) {
+        children.push_back(make_tree(tc, seed * 31 + i + 1, depth - 1));
+    }
+    return xl::mvc::MVCModel::make_symbol(tc, 100 + depth, children);
+}
+
+static std::string render_tree(uint32_t seed)
+{
+    xl::Allocator alloc(__FILE__);
+    xl::TreeContext tc(alloc);
+    xl::node::NodeIdentIFace* tree = make_tree(&tc, seed, 2 + seed % 4);
+    xl::mvc::MVCView::print_dot(tree); // names nodes by address, so not compared
+    return xl::mvc::MVCView::print_graph(tree, seed) +
+           xl::mvc::MVCView::print_lisp(tree) +
+           xl::system::get_execname();
+}
+
+struct stress_job_t
+{
+    const std::vector<std::string>* m_expected;
+    int                             m_mismatch_count;
+};
+
+static void* do_stress_job(void* args)
+{
+    stress_job_t* job = reinterpret_cast<stress_job_t*>(args);
+    for(uint32_t seed = 0; seed < TREE_COUNT; seed++) {
+        if(render_tree(seed) != (*job->m_expected)[seed]) {
+            job->m_mismatch_count++;
+        }
+    }
+    return NULL;
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> expected;
+    size_t widest = 0;
+    for(uint32_t seed = 0; seed < TREE_COUNT; seed++) {
+        expected.push_back(render_tree(seed));
+        std::stringstream ss(expected.back());
+        std::string line;
+        while(std::getline(ss, line)) {
+            widest = std::max(widest, line.size());
+        }
+    }
+    pthread_t threads[THREAD_COUNT];
+    stress_job_t jobs[THREAD_COUNT];
+    for(int i = 0; i < THREAD_COUNT; i++) {
+        jobs[i].m_expected       = &expected;
+        jobs[i].m_mismatch_count = 0;
+        if(pthread_create(&threads[i], NULL, do_stress_job, &jobs[i]) != 0) {
+            std::cout << "failed to create thread " << i << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    int mismatch_count = 0;
+    for(int j = 0; j < THREAD_COUNT; j++) {
+        pthread_join(threads[j], NULL);
+        mismatch_count += jobs[j].m_mismatch_count;
+    }
+    std::cout << "threads: " << THREAD_COUNT << std::endl
+              << "trees rendered: " << THREAD_COUNT * TREE_COUNT << std::endl
+              << "widest line: " << widest << std::endl
+              << "mismatches: " << mismatch_count << std::endl;
+    return mismatch_count ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -22,6 +22,7 @@
 #include <string> // std::string
 #include <stddef.h> // size_t
 #include <list> // std::list
+#include <atomic> // std::atomic
 
 #define DTOR_CB(ns, c) [](void* x) {      \
         reinterpret_cast<ns c*>(x)->~c(); \
@@ -30,6 +31,8 @@
         reinterpret_cast<ns c*>(x)->~f();  \
         }
 
+#define ERROR_MEM_BUDGET_EXCEEDED "Memory budget exceeded"
+
 #define PNEW_LOC(a) \
         (a), __FILE__, __LINE__
 
@@ -45,46 +48,69 @@ class MemChunk
 public:
     typedef void (*dtor_cb_t)(void*);
 
-    MemChunk(size_t _size_bytes, std::string _filename, size_t _line_number, dtor_cb_t dtor_cb = NULL);
+    MemChunk(size_t _size_bytes, const char* _filename, size_t _line_number, dtor_cb_t dtor_cb = NULL);
     ~MemChunk();
     void* ptr() const { return m_ptr; }
     size_t size() const { return m_size_bytes; }
-    std::string filename() const { return m_filename; }
+    const char* filename() const { return m_filename; }
     size_t line_number() const { return m_line_number; }
-    std::string dump(std::string indent) const;
+    std::string dump(const std::string &indent) const;
 
 private:
     size_t m_size_bytes;
-    std::string m_filename;
+    const char* m_filename; // always __FILE__, never owned
     size_t m_line_number;
     dtor_cb_t m_dtor_cb;
     void* m_ptr;
 };
 
+// Byte budget shared by any number of allocators across threads. A budget
+// may have a parent (per sentence -> per process); a charge must fit in
+// every budget up the chain or none of them is charged.
+class MemBudget
+{
+public:
+    MemBudget(size_t _limit_bytes = 0, MemBudget* parent = NULL);
+    bool charge(size_t size_bytes);
+    void refund(size_t size_bytes);
+    size_t limit() const { return m_limit_bytes; } // 0 for no limit
+    size_t used() const { return m_used_bytes.load(std::memory_order_relaxed); }
+    size_t peak() const { return m_peak_bytes.load(std::memory_order_relaxed); }
+
+private:
+    size_t              m_limit_bytes;
+    MemBudget*          m_parent;
+    std::atomic<size_t> m_used_bytes;
+    std::atomic<size_t> m_peak_bytes;
+};
+
 class Allocator
 {
 public:
-    Allocator(std::string _filename);
+    Allocator(const std::string &_filename);
     ~Allocator();
-    std::string name() const { return m_name; }
+    const std::string &name() const { return m_name; }
     size_t size() const { return m_size_bytes; }
-    void* _malloc(size_t size_bytes, std::string filename, size_t line_number, MemChunk::dtor_cb_t dtor_cb = NULL);
+    void set_budget(MemBudget* budget) { m_budget = budget; }
+    MemBudget* budget() const { return m_budget; }
+    void* _malloc(size_t size_bytes, const char* filename, size_t line_number, MemChunk::dtor_cb_t dtor_cb = NULL);
     void _free(void* ptr);
     void _free();
-    std::string dump(std::string indent) const;
+    std::string dump(const std::string &indent) const;
 
 private:
     typedef std::map<void*, MemChunk*> internal_type_t;
     std::string m_name;
     internal_type_t m_chunk_map;
     size_t m_size_bytes;
+    MemBudget* m_budget;
 };
 
 }
 
 // NOTE: doesn't work for arrays
-void* operator new(size_t size_bytes, xl::Allocator &alloc, std::string filename, size_t line_number,
+void* operator new(size_t size_bytes, xl::Allocator &alloc, const char* filename, size_t line_number,
         xl::MemChunk::dtor_cb_t dtor_cb);
-void* operator new(size_t size_bytes, xl::Allocator &alloc, std::string filename, size_t line_number);
+void* operator new(size_t size_bytes, xl::Allocator &alloc, const char* filename, size_t line_number);
 
 #endif
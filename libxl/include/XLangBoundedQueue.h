@@ -0,0 +1,103 @@
+// XLang
+// -- A minimum viable English parser implemented in LexYacc
+// Copyright (C) 2011 onlyuser <mailto:onlyuser@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef XLANG_BOUNDED_QUEUE_H_
+#define XLANG_BOUNDED_QUEUE_H_
+
+#include <deque> // std::deque
+#include <pthread.h> // pthread_mutex_t
+#include <stddef.h> // size_t
+
+namespace xl {
+
+// Blocking FIFO that hands work from one pipeline stage to the next. push
+// waits while the queue is full, so a fast stage can't run ahead of a slow
+// one by more than capacity items. A pick function, if given, chooses which
+// queued item pop hands out in place of the oldest.
+template<class T>
+class BoundedQueue
+{
+public:
+    typedef typename std::deque<T>::iterator (*pick_t)(std::deque<T> &queue);
+
+    BoundedQueue(size_t capacity, pick_t pick = NULL)
+        : m_capacity(capacity ? capacity : 1), m_pick(pick)
+    {
+        pthread_mutex_init(&m_mutex, NULL);
+        pthread_cond_init(&m_not_empty, NULL);
+        pthread_cond_init(&m_not_full, NULL);
+    }
+    ~BoundedQueue()
+    {
+        pthread_cond_destroy(&m_not_full);
+        pthread_cond_destroy(&m_not_empty);
+        pthread_mutex_destroy(&m_mutex);
+    }
+
+    void push(const T &value)
+    {
+        pthread_mutex_lock(&m_mutex);
+        while(m_queue.size() >= m_capacity)
+            pthread_cond_wait(&m_not_full, &m_mutex);
+        m_queue.push_back(value);
+        pthread_cond_signal(&m_not_empty);
+        pthread_mutex_unlock(&m_mutex);
+    }
+    T pop()
+    {
+        pthread_mutex_lock(&m_mutex);
+        while(m_queue.empty())
+            pthread_cond_wait(&m_not_empty, &m_mutex);
+        typename std::deque<T>::iterator p = m_pick ? m_pick(m_queue) : m_queue.begin();
+        T value = *p;
+        m_queue.erase(p);
+        pthread_cond_signal(&m_not_full);
+        pthread_mutex_unlock(&m_mutex);
+        return value;
+    }
+    // pop without waiting; false if the queue is empty
+    bool try_pop(T* value)
+    {
+        pthread_mutex_lock(&m_mutex);
+        if(m_queue.empty())
+        {
+            pthread_mutex_unlock(&m_mutex);
+            return false;
+        }
+        typename std::deque<T>::iterator p = m_pick ? m_pick(m_queue) : m_queue.begin();
+        *value = *p;
+        m_queue.erase(p);
+        pthread_cond_signal(&m_not_full);
+        pthread_mutex_unlock(&m_mutex);
+        return true;
+    }
+
+private:
+    size_t          m_capacity;
+    pick_t          m_pick;
+    std::deque<T>   m_queue;
+    pthread_mutex_t m_mutex;
+    pthread_cond_t  m_not_empty;
+    pthread_cond_t  m_not_full;
+
+    BoundedQueue(const BoundedQueue &);
+    BoundedQueue &operator=(const BoundedQueue &);
+};
+
+}
+
+#endif
@@ -0,0 +1,83 @@
+// XLang
+// -- A minimum viable English parser implemented in LexYacc
+// Copyright (C) 2011 onlyuser <mailto:onlyuser@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef XLANG_CONS_CONTEXT_H_
+#define XLANG_CONS_CONTEXT_H_
+
+#include "XLangTreeContext.h" // TreeContext
+#include "XLangAlloc.h" // Allocator
+#include "XLangType.h" // uint32_t
+#include <string> // std::string
+#include <map> // std::map
+#include <vector> // std::vector
+#include <stddef.h> // size_t
+
+namespace xl { namespace node { class NodeIdentIFace; } }
+
+namespace xl {
+
+// TreeContext that hash-conses finished trees: intern() returns a copy in
+// which structurally identical subtrees (same lexer id and value, or same
+// lexer id and interned children) are stored once, so the trees of several
+// parses share nodes and form a DAG. Interned nodes carry no parent links
+// (parent() is NULL, index() is -1), so walk interned trees top-down only;
+// printers that draw edges from parent() can't render them.
+// Interning runs on finished trees, so it shrinks what is kept, not the peak
+// while a tree is built. The index of keys is charged to alloc()'s budget.
+// NOTE: not thread-safe
+class ConsContext : public TreeContext
+{
+public:
+    ConsContext(Allocator &alloc)
+        : TreeContext(alloc), m_unique_bytes(0), m_index_bytes(0), m_shared_count(0), m_shared_bytes(0)
+    {}
+    ~ConsContext();
+    node::NodeIdentIFace* intern(const node::NodeIdentIFace* _node);
+    size_t unique_count() const { return m_cons_map.size(); }
+    size_t unique_bytes() const { return m_unique_bytes; }
+    size_t index_bytes() const  { return m_index_bytes; } // approximate
+    size_t shared_count() const { return m_shared_count; }
+    size_t shared_bytes() const { return m_shared_bytes; }
+
+private:
+    struct cons_key_t
+    {
+        int                                 m_type;
+        uint32_t                            m_lexer_id;
+        std::string                         m_value;     // terms only
+        std::vector<node::NodeIdentIFace*>  m_child_vec; // symbols only, already interned
+
+        bool operator<(const cons_key_t &other) const;
+    };
+    struct cons_entry_t
+    {
+        node::NodeIdentIFace* m_node;
+        size_t                m_size_bytes; // what a copy costs in alloc()
+    };
+    typedef std::map<cons_key_t, cons_entry_t> cons_map_t;
+    cons_map_t m_cons_map;
+    size_t     m_unique_bytes;
+    size_t     m_index_bytes;
+    size_t     m_shared_count;
+    size_t     m_shared_bytes;
+
+    node::NodeIdentIFace* make_copy(const node::NodeIdentIFace* _node, const cons_key_t &key);
+};
+
+}
+
+#endif
@@ -0,0 +1,75 @@
+// XLang
+// -- A minimum viable English parser implemented in LexYacc
+// Copyright (C) 2011 onlyuser <mailto:onlyuser@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef XLANG_HASH_H_
+#define XLANG_HASH_H_
+
+#include "XLangType.h" // uint64_t
+#include <string> // std::string
+#include <string.h> // memcpy
+#include <stddef.h> // size_t
+
+namespace xl {
+
+// 64-bit FNV-1a
+inline uint64_t hash_bytes(const void* data, size_t size_bytes, uint64_t seed = 14695981039346656037ULL)
+{
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+    uint64_t h = seed;
+    for(size_t i = 0; i<size_bytes; i++)
+    {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// same as hash_bytes over a string literal, usable as a case label
+constexpr uint64_t hash_cstr(const char* s, uint64_t h = 14695981039346656037ULL)
+{
+    return *s ? hash_cstr(s+1, (h^static_cast<unsigned char>(*s))*1099511628211ULL) : h;
+}
+
+// order-dependent, so folding a child sequence left to right can be resumed
+// where it left off when children are appended
+inline uint64_t hash_combine(uint64_t h, uint64_t value)
+{
+    return h ^ (value+0x9e3779b97f4a7c15ULL+(h << 6)+(h >> 2));
+}
+
+inline uint64_t hash_value(long value)
+{
+    return hash_bytes(&value, sizeof(value));
+}
+inline uint64_t hash_value(float32_t value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return hash_bytes(&bits, sizeof(bits));
+}
+inline uint64_t hash_value(char value)
+{
+    return hash_bytes(&value, sizeof(value));
+}
+inline uint64_t hash_value(const std::string* value)
+{
+    return value ? hash_bytes(value->data(), value->size()) : 0;
+}
+
+}
+
+#endif
@@ -0,0 +1,125 @@
+// XLang
+// -- A minimum viable English parser implemented in LexYacc
+// Copyright (C) 2011 onlyuser <mailto:onlyuser@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef XLANG_SMALL_VECTOR_H_
+#define XLANG_SMALL_VECTOR_H_
+
+#include <stddef.h> // size_t
+#include <string.h> // memcpy
+
+namespace xl {
+
+// Vector of trivially copyable elements that keeps the first N inline and
+// only touches the heap once it grows past that.
+template<class T, size_t N>
+class SmallVector
+{
+public:
+    typedef T*       iterator;
+    typedef const T* const_iterator;
+
+    SmallVector()
+        : m_data(m_inline), m_size(0), m_capacity(N)
+    {}
+    SmallVector(const SmallVector &other)
+        : m_data(m_inline), m_size(0), m_capacity(N)
+    {
+        insert(end(), other.begin(), other.end());
+    }
+    ~SmallVector()
+    {
+        if(m_data != m_inline)
+            delete[] m_data;
+    }
+    SmallVector &operator=(const SmallVector &other)
+    {
+        if(this != &other)
+        {
+            clear();
+            insert(end(), other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    iterator       begin()       { return m_data; }
+    const_iterator begin() const { return m_data; }
+    iterator       end()         { return m_data+m_size; }
+    const_iterator end() const   { return m_data+m_size; }
+    size_t size() const          { return m_size; }
+    bool   empty() const         { return !m_size; }
+    T       &operator[](size_t index)       { return m_data[index]; }
+    const T &operator[](size_t index) const { return m_data[index]; }
+
+    void reserve(size_t capacity)
+    {
+        if(capacity <= m_capacity)
+            return;
+        T* data = new T[capacity];
+        memcpy(data, m_data, m_size*sizeof(T));
+        if(m_data != m_inline)
+            delete[] m_data;
+        m_data     = data;
+        m_capacity = capacity;
+    }
+    void push_back(const T &value)
+    {
+        T _value(value); // value may live in the buffer reserve() frees
+        if(m_size == m_capacity)
+            reserve(m_capacity*2);
+        m_data[m_size++] = _value;
+    }
+    iterator insert(iterator pos, const T &value)
+    {
+        T _value(value); // value may live in the buffer reserve() frees
+        return insert(pos, &_value, &_value+1);
+    }
+    iterator insert(iterator pos, const_iterator first, const_iterator last)
+    {
+        size_t index = pos-m_data;
+        size_t count = last-first;
+        if(m_size+count > m_capacity)
+            reserve(m_size+count > m_capacity*2 ? m_size+count : m_capacity*2);
+        memmove(m_data+index+count, m_data+index, (m_size-index)*sizeof(T));
+        memcpy(m_data+index, first, count*sizeof(T));
+        m_size += count;
+        return m_data+index;
+    }
+    iterator erase(iterator pos)
+    {
+        return erase(pos, pos+1);
+    }
+    iterator erase(iterator first, iterator last)
+    {
+        memmove(first, last, (end()-last)*sizeof(T));
+        m_size -= last-first;
+        return first;
+    }
+    void clear()
+    {
+        m_size = 0;
+    }
+
+private:
+    T*     m_data;
+    size_t m_size;
+    size_t m_capacity;
+    T      m_inline[N];
+};
+
+}
+
+#endif
@@ -23,19 +23,19 @@
 
 namespace xl {
 
-bool                     read_file(std::string filename, std::string &s);
-std::string              replace(std::string &s, std::string find_string, std::string replace_string);
+bool                     read_file(const std::string &filename, std::string &s);
+std::string              replace(const std::string &s, const std::string &find_string, const std::string &replace_string);
 std::vector<std::string> tokenize(const std::string &s, const char* delim = " ");
-std::string              escape_xml(std::string &s);
-std::string              unescape_xml(std::string &s);
-std::string              escape(std::string &s);
-std::string              unescape(std::string &s);
+std::string              escape_xml(const std::string &s);
+std::string              unescape_xml(const std::string &s);
+std::string              escape(const std::string &s);
+std::string              unescape(const std::string &s);
 std::string              escape(char c);
 char                     unescape(char c);
 
-bool regexp(std::string &s, std::string pattern, std::vector<std::string*> &cap_groups);
-bool regexp(std::string &s, std::string pattern, int nmatch, ...);
-bool regsub(std::string &s, std::string pattern, int nmatch, std::string replace_string);
+bool regexp(const std::string &s, const std::string &pattern, std::vector<std::string*> &cap_groups);
+bool regexp(const std::string &s, const std::string &pattern, int nmatch, ...);
+bool regsub(std::string &s, const std::string &pattern, int nmatch, const std::string &replace_string);
 
 }
 
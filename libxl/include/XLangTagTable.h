@@ -0,0 +1,60 @@
+// XLang
+// -- A minimum viable English parser implemented in LexYacc
+// Copyright (C) 2011 onlyuser <mailto:onlyuser@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// NOTE: no include guard, included once per table
+
+// Expands a declarative word -> tag table into a lookup function.
+//
+// The spec named by XLANG_TAG_TABLE_SPEC is a list of
+//   TAG_SET(name, "TAG", ...) -- a tag list shared by several words
+//   TAG_WORD("word", name)    -- the tags a word may take, in order
+// and XLANG_TAG_TABLE_FUNC names the function defined here:
+//   const char* const* XLANG_TAG_TABLE_FUNC(const std::string &word);
+// which returns the word's NULL-terminated tags, or NULL if it has none.
+//
+// The lookup switches on the word's FNV hash against the same hash taken of
+// each spec word at compile time, so it costs one hash and one compare; two
+// spec words that collide are duplicate case labels and fail to compile.
+
+#include "XLangHash.h" // hash_bytes, hash_cstr
+#include <string> // std::string
+
+#if !defined(XLANG_TAG_TABLE_SPEC) || !defined(XLANG_TAG_TABLE_FUNC)
+    #error "define XLANG_TAG_TABLE_SPEC and XLANG_TAG_TABLE_FUNC first"
+#endif
+
+#define TAG_SET(name, ...) static const char* const name[] = {__VA_ARGS__, NULL};
+#define TAG_WORD(word, name)
+#include XLANG_TAG_TABLE_SPEC
+#undef TAG_SET
+#undef TAG_WORD
+
+const char* const* XLANG_TAG_TABLE_FUNC(const std::string &word)
+{
+    switch(xl::hash_bytes(word.data(), word.size()))
+    {
+#define TAG_SET(name, ...)
+#define TAG_WORD(_word, name) case xl::hash_cstr(_word): return (word == _word) ? name : NULL;
+#include XLANG_TAG_TABLE_SPEC
+#undef TAG_SET
+#undef TAG_WORD
+    }
+    return NULL;
+}
+
+#undef XLANG_TAG_TABLE_SPEC
+#undef XLANG_TAG_TABLE_FUNC
@@ -34,8 +34,8 @@ public:
     {}
     Allocator &alloc() { return m_alloc; }
     node::NodeIdentIFace* &root() { return m_root; }
-    const std::string* alloc_unique_string(std::string name);
-    std::string* alloc_string(std::string s);
+    const std::string* alloc_unique_string(const std::string &name);
+    std::string* alloc_string(const std::string &s);
 
 private:
     Allocator &m_alloc;
@@ -48,7 +48,7 @@ private:
             return *s1 < *s2;
         }
     };
-    typedef std::set<std::string*, str_ptr_compare_t> string_set_t;
+    typedef std::set<const std::string*, str_ptr_compare_t> string_set_t;
     string_set_t m_string_set;
 };
 
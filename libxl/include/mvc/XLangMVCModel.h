@@ -36,8 +36,26 @@ struct MVCModel
                 static_cast<node::NodeIdentIFace::type_t>(node::TermType<T>::type)
                 >(lexer_id, value); // assumes trivial dtor
     }
-    static node::SymbolNode* make_symbol(TreeContext* tc, uint32_t lexer_id, size_t size, ...);
+    template<class... T>
+    static node::SymbolNode* make_symbol(TreeContext* tc, uint32_t lexer_id, T... children)
+    {
+        node::NodeIdentIFace* child_arr[] = {children..., NULL}; // NULL keeps zero arity legal
+        return new (PNEW(tc->alloc(), node::, NodeIdentIFace))
+                node::SymbolNode(lexer_id, sizeof...(children), child_arr);
+    }
     static node::SymbolNode* make_symbol(TreeContext* tc, uint32_t lexer_id, std::vector<node::NodeIdentIFace*>& vec);
+    // left-recursive list rules: extend the list in place rather than
+    // re-flattening it into a fresh node on every reduction
+    template<class... T>
+    static node::NodeIdentIFace* append_symbol(TreeContext* tc, uint32_t lexer_id, node::NodeIdentIFace* list,
+            T... children)
+    {
+        if(!list || list->type() != node::NodeIdentIFace::SYMBOL || list->lexer_id() != lexer_id)
+            return make_symbol(tc, lexer_id, list, children...);
+        node::NodeIdentIFace* child_arr[] = {children..., NULL};
+        static_cast<node::SymbolNode*>(node::symbol_cast(list))->append(sizeof...(children), child_arr);
+        return list;
+    }
     static node::NodeIdentIFace* make_ast(TreeContext* tc, std::string filename);
 };
 
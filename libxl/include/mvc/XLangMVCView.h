@@ -21,6 +21,8 @@
 #include "visitor/XLangVisitor.h" // visitor::VisitorDFS
 #include "visitor/XLangFilterable.h" // visitor::Filterable
 #include "XLangType.h" // NULL
+#include <string> // std::string
+#include <stddef.h> // size_t
 
 namespace xl { namespace node { class NodeIdentIFace; } }
 
@@ -41,7 +43,7 @@ struct MVCView
                                        bool                  print_digraph_block = true);
     static std::string print_dot_header(bool horizontal);
     static std::string print_dot_footer();
-    static std::string print_graph(const node::NodeIdentIFace* p);
+    static std::string print_graph(const node::NodeIdentIFace* p, size_t graph_number = 0);
 };
 
 } }
@@ -0,0 +1,204 @@
+// XLang
+// -- A minimum viable English parser implemented in LexYacc
+// Copyright (C) 2011 onlyuser <mailto:onlyuser@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef XLANG_FLAT_TREE_H_
+#define XLANG_FLAT_TREE_H_
+
+#include "node/XLangNodeIFace.h" // node::NodeIdentIFace
+#include "XLangAlloc.h" // MemBudget
+#include "XLangType.h" // uint32_t
+#include <string> // std::string
+#include <vector> // std::vector
+#include <stddef.h> // size_t
+
+namespace xl { namespace node {
+
+// Struct-of-arrays AST. Every node is a slot index into parallel arrays; a
+// symbol's children sit contiguously in one shared child array, so the n-th
+// child and a node's position among its siblings are O(1) and a symbol costs
+// no heap block of its own. Slots are appended bottom-up, exactly the way a
+// LALR parser reduces, so the same make_term/make_symbol/append_symbol calls
+// used with MVCModel work here with slot indices in place of node pointers.
+// Appending to a list whose run is no longer last, or adopting a same-type
+// child, moves a run and strands the old one; compact() reclaims them.
+class FlatTree
+{
+public:
+    typedef int32_t index_t;
+
+    static const index_t NIL = -1; // NULL child, printed as "NULL"
+    static const index_t EOL = -2; // dropped, like SymbolNode::eol()
+
+    union value_t
+    {
+        long               int_value;
+        float32_t          float_value;
+        std::string*       string_value;
+        char               char_value;
+        const std::string* ident_value;
+    };
+
+    FlatTree()
+        : m_root(NIL), m_garbage_count(0), m_budget(NULL)
+    {}
+    ~FlatTree();
+
+    // build
+    template<class T>
+    index_t make_term(uint32_t lexer_id, T value);
+    template<class... T>
+    index_t make_symbol(uint32_t lexer_id, T... children)
+    {
+        index_t child_arr[] = {children..., EOL}; // EOL keeps zero arity legal
+        return make_symbol_from_array(lexer_id, sizeof...(children), child_arr);
+    }
+    index_t make_symbol(uint32_t lexer_id, const std::vector<index_t> &vec);
+    template<class... T>
+    index_t append_symbol(uint32_t lexer_id, index_t list, T... children)
+    {
+        index_t child_arr[] = {children..., EOL};
+        return append_symbol_from_array(lexer_id, list, sizeof...(children), child_arr);
+    }
+    index_t import(const NodeIdentIFace* _node);
+    void compact(); // drops slots and child runs the root can't reach, renumbering in pre-order
+    void reserve(size_t n);
+    void clear();
+    void set_budget(MemBudget* budget); // charged as slots are added; throws ERROR_MEM_BUDGET_EXCEEDED
+
+    // access
+    index_t &root()
+    {
+        return m_root;
+    }
+    index_t root() const
+    {
+        return m_root;
+    }
+    size_t size() const
+    {
+        return m_lexer_id.size();
+    }
+    size_t size_bytes() const;
+    size_t garbage_count() const // slots and child-array entries compact() would drop
+    {
+        return m_garbage_count;
+    }
+    bool is_null(index_t index) const
+    {
+        return m_type[index] == NULL_SLOT;
+    }
+    NodeIdentIFace::type_t type(index_t index) const
+    {
+        return static_cast<NodeIdentIFace::type_t>(m_type[index]);
+    }
+    uint32_t lexer_id(index_t index) const
+    {
+        return m_lexer_id[index];
+    }
+    index_t parent(index_t index) const
+    {
+        return m_parent[index];
+    }
+    index_t first_child(index_t index) const
+    {
+        return child(index, 0);
+    }
+    index_t next_sibling(index_t index) const;
+    uint32_t child_count(index_t index) const
+    {
+        return m_child_count[index];
+    }
+    index_t child(index_t index, uint32_t n) const
+    {
+        return (n < m_child_count[index]) ? m_child_vec[m_child_offset[index]+n] : NIL;
+    }
+    uint32_t sibling_index(index_t index) const // position among the parent's children
+    {
+        return m_sibling_index[index];
+    }
+    const value_t &value(index_t index) const
+    {
+        return m_value[index];
+    }
+
+private:
+    static const uint8_t NULL_SLOT = 0xFF;
+    static const size_t  SLOT_BYTES = sizeof(uint8_t)+sizeof(uint32_t)+sizeof(index_t)+3*sizeof(uint32_t)+sizeof(value_t);
+
+    std::vector<uint8_t>  m_type;
+    std::vector<uint32_t> m_lexer_id;
+    std::vector<index_t>  m_parent;
+    std::vector<uint32_t> m_child_offset;  // into m_child_vec
+    std::vector<uint32_t> m_child_count;
+    std::vector<uint32_t> m_sibling_index;
+    std::vector<value_t>  m_value;
+    std::vector<index_t>  m_child_vec;     // every symbol's children, one run per symbol
+    index_t               m_root;
+    size_t                m_garbage_count;
+    MemBudget*            m_budget;
+
+    index_t alloc_slot(uint8_t _type, uint32_t lexer_id);
+    index_t make_symbol_from_array(uint32_t lexer_id, size_t size, const index_t* children);
+    index_t append_symbol_from_array(uint32_t lexer_id, index_t list, size_t size, const index_t* children);
+    index_t copy_subtree(const FlatTree &tree, index_t index);
+    void append_child(index_t parent_index, index_t child_index);
+    void adopt_child(index_t parent_index, index_t child_index);
+    void charge(size_t size_bytes);
+
+    FlatTree(const FlatTree &);
+    FlatTree &operator=(const FlatTree &);
+};
+
+template<> FlatTree::index_t FlatTree::make_term(uint32_t lexer_id, long value);
+template<> FlatTree::index_t FlatTree::make_term(uint32_t lexer_id, float32_t value);
+template<> FlatTree::index_t FlatTree::make_term(uint32_t lexer_id, std::string* value);
+template<> FlatTree::index_t FlatTree::make_term(uint32_t lexer_id, char value);
+template<> FlatTree::index_t FlatTree::make_term(uint32_t lexer_id, const std::string* value);
+
+// Adapter exposing a FlatTree through NodeIdentIFace so the existing
+// visitors, printers and tree walkers run over it unchanged. Proxy nodes are
+// created on first touch in per-type pools owned by the view, so they cost
+// no allocation of their own.
+class FlatTreeView
+{
+public:
+    FlatTreeView(const FlatTree &tree);
+    ~FlatTreeView();
+    NodeIdentIFace* root() const
+    {
+        return node(m_tree.root());
+    }
+    NodeIdentIFace* node(FlatTree::index_t index) const;
+    const FlatTree &tree() const
+    {
+        return m_tree;
+    }
+
+private:
+    struct proxy_pool_t; // per-type proxy storage, see XLangFlatTree.cpp
+
+    const FlatTree                       &m_tree;
+    mutable std::vector<NodeIdentIFace*>  m_proxy_vec;
+    proxy_pool_t*                         m_proxy_pool;
+
+    FlatTreeView(const FlatTreeView &);
+    FlatTreeView &operator=(const FlatTreeView &);
+};
+
+} }
+
+#endif
@@ -20,10 +20,12 @@
 
 #include "node/XLangNodeIFace.h" // node::NodeIdentIFace
 #include "XLangTreeContext.h" // TreeContext
+#include "XLangSmallVector.h" // SmallVector
+#include "XLangHash.h" // hash_combine
 #include "XLangType.h" // uint32_t
+#include <stdint.h> // uintptr_t
 #include <string> // std::string
 #include <vector> // std::vector
-#include <stdarg.h> // va_list
 
 namespace xl { namespace node {
 
@@ -31,7 +33,8 @@ class Node : virtual public NodeIdentIFace
 {
 public:
     Node(NodeIdentIFace::type_t _type, uint32_t _lexer_id)
-        : m_type(_type), m_lexer_id(_lexer_id), m_parent(NULL), m_original(NULL),
+        : m_type(_type), m_lexer_id(_lexer_id), m_parent(NULL), m_index(-1),
+          m_original(NULL), m_hash(seed_hash(_type, _lexer_id)),
           m_depth(-1), m_height(-1), m_bfs_index(-1)
     {}
 
@@ -57,7 +60,14 @@ public:
 
     // optional
     void detach();
-    int index() const;
+    int index() const
+    {
+        return m_parent ? m_index : -1;
+    }
+    void set_index(int index)
+    {
+        m_index = index;
+    }
     void set_original(const NodeIdentIFace* original)
     {
         m_original = original;
@@ -66,6 +76,10 @@ public:
     {
         return m_original ? m_original : this;
     }
+    uint64_t hash() const
+    {
+        return m_hash;
+    }
 
     // visitation-related
     void set_depth(int depth)
@@ -97,10 +111,17 @@ protected:
     NodeIdentIFace::type_t m_type;
     uint32_t               m_lexer_id;
     NodeIdentIFace*        m_parent;
+    int                    m_index; // slot in m_parent, kept by SymbolNode
     const NodeIdentIFace*  m_original;
+    uint64_t               m_hash; // structural, computed bottom-up
     int                    m_depth;
     int                    m_height;
     int                    m_bfs_index;
+
+    static uint64_t seed_hash(NodeIdentIFace::type_t _type, uint32_t _lexer_id)
+    {
+        return hash_combine(hash_value(static_cast<long>(_type)), _lexer_id);
+    }
 };
 
 template<NodeIdentIFace::type_t _type>
@@ -109,7 +130,9 @@ class TermNode : public Node, public TermNodeIFace<_type>
 public:
     TermNode(uint32_t _lexer_id, typename TermInternalType<_type>::type _value)
         : Node(_type, _lexer_id), m_value(_value)
-    {}
+    {
+        m_hash = hash_combine(m_hash, hash_value(_value));
+    }
     typename TermInternalType<_type>::type value() const
     {
         return m_value;
@@ -121,9 +144,9 @@ public:
     }
     bool compare(const NodeIdentIFace* _node) const
     {
-        if(!is_same_type(_node))
+        if(!is_same_type(_node) || !same_hash(_node))
             return false;
-        return m_value == dynamic_cast<const TermNode<_type>*>(_node)->value();
+        return m_value == term_cast<_type>(_node)->value();
     }
 
 private:
@@ -133,7 +156,7 @@ private:
 class SymbolNode : public Node, public SymbolNodeIFace
 {
 public:
-    SymbolNode(uint32_t _lexer_id, size_t _size, va_list ap);
+    SymbolNode(uint32_t _lexer_id, size_t _size, NodeIdentIFace* const* children);
     SymbolNode(uint32_t _lexer_id, std::vector<NodeIdentIFace*>& vec);
 
     // required
@@ -150,14 +173,23 @@ public:
     NodeIdentIFace* clone(TreeContext* tc) const;
     bool compare(const NodeIdentIFace* _node) const
     {
-        if(!is_same_type(_node))
+        if(this == _node)
+            return true;
+        if(!is_same_type(_node) || !same_hash(_node))
             return false;
-        auto symbol_node = dynamic_cast<const SymbolNode*>(_node);
+        auto symbol_node = symbol_cast(_node);
         if(m_child_vec.size() != symbol_node->size())
             return false;
         for(size_t i = 0; i<m_child_vec.size(); i++)
         {
-            if(!m_child_vec[i]->compare(const_cast<const NodeIdentIFace*>((*symbol_node)[i])))
+            const NodeIdentIFace* other_child = (*symbol_node)[i];
+            if(!m_child_vec[i] || !other_child)
+            {
+                if(m_child_vec[i] != other_child)
+                    return false;
+                continue;
+            }
+            if(!m_child_vec[i]->compare(other_child))
                 return false;
         }
         return true;
@@ -172,22 +204,33 @@ public:
         return NULL;
     }
     void push_back(NodeIdentIFace* _node);
+    void push_back_shared(NodeIdentIFace* _node);
     void push_front(NodeIdentIFace* _node);
     void insert_after(NodeIdentIFace* after_node, NodeIdentIFace* _node);
     void remove_first(NodeIdentIFace* _node);
     void replace_first(NodeIdentIFace* find_node, NodeIdentIFace* replace_node);
     void erase(int index);
     NodeIdentIFace* find_if(bool (*pred)(const NodeIdentIFace* _node)) const;
+    void append(size_t _size, NodeIdentIFace* const* children);
 
     // built-in
+    // sentinel child dropped on construction; a misaligned address no node can have
     static NodeIdentIFace* eol()
     {
-        static int dummy;
-        return reinterpret_cast<NodeIdentIFace*>(&dummy);
+        return reinterpret_cast<NodeIdentIFace*>(static_cast<uintptr_t>(-1));
     }
 
 private:
-    std::vector<NodeIdentIFace*> m_child_vec;
+    // most grammar rules have at most 4 children; longer lists spill to the heap
+    typedef SmallVector<NodeIdentIFace*, 4> child_vec_t;
+    child_vec_t m_child_vec;
+
+    void adopt(size_t index);
+    void adopt_from(size_t index);
+    void rehash();
+    void rehash_from(size_t index);
+    void rehash_ancestors();
+    child_vec_t::iterator locate(NodeIdentIFace* _node);
 };
 
 } }
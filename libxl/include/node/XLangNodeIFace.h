@@ -47,6 +47,8 @@ struct NodeIdentIFace
     {
         return -1;
     }
+    virtual void set_index(int index)
+    {}
     virtual NodeIdentIFace* clone(TreeContext* tc) const
     {
         return NULL;
@@ -61,6 +63,10 @@ struct NodeIdentIFace
     {
         return NULL;
     }
+    virtual uint64_t hash() const
+    {
+        return 0; // no cached structural hash
+    }
 
     // visitation-related
     virtual void set_depth(int depth)
@@ -83,10 +89,16 @@ struct NodeIdentIFace
     }
 
     // built-in (part of interface)
+    // NOTE: "this" as the interface named by type(), for term_cast/symbol_cast
+    virtual const void* iface() const = 0;
     bool is_same_type(const NodeIdentIFace* _node) const
     {
         return type() == _node->type() && lexer_id() == _node->lexer_id();
     }
+    bool same_hash(const NodeIdentIFace* _node) const
+    {
+        return !hash() || !_node->hash() || hash() == _node->hash();
+    }
     bool is_root() const
     {
         return parent() == NULL;
@@ -117,12 +129,20 @@ struct TermNodeIFace : virtual public NodeIdentIFace
     virtual ~TermNodeIFace()
     {}
     virtual typename TermInternalType<T>::type value() const = 0;
+    const void* iface() const
+    {
+        return this;
+    }
 };
 
 struct SymbolNodeIFace : virtual public NodeIdentIFace
 {
     virtual ~SymbolNodeIFace()
     {}
+    const void* iface() const
+    {
+        return this;
+    }
 
     // required
     virtual NodeIdentIFace* operator[](uint32_t index) const = 0;
@@ -151,6 +171,36 @@ struct SymbolNodeIFace : virtual public NodeIdentIFace
     }
 };
 
+// Tag-based downcasts. The interfaces inherit NodeIdentIFace virtually, which
+// rules out static_cast from the base; type() picks the target and iface()
+// supplies the adjusted pointer, so no RTTI lookup is needed. Like
+// dynamic_cast, both return NULL when the tag doesn't match.
+template<NodeIdentIFace::type_t T>
+inline const TermNodeIFace<T>* term_cast(const NodeIdentIFace* _node)
+{
+    if(!_node || _node->type() != T)
+        return NULL;
+    return static_cast<const TermNodeIFace<T>*>(_node->iface());
+}
+
+template<NodeIdentIFace::type_t T>
+inline TermNodeIFace<T>* term_cast(NodeIdentIFace* _node)
+{
+    return const_cast<TermNodeIFace<T>*>(term_cast<T>(const_cast<const NodeIdentIFace*>(_node)));
+}
+
+inline const SymbolNodeIFace* symbol_cast(const NodeIdentIFace* _node)
+{
+    if(!_node || _node->type() != NodeIdentIFace::SYMBOL)
+        return NULL;
+    return static_cast<const SymbolNodeIFace*>(_node->iface());
+}
+
+inline SymbolNodeIFace* symbol_cast(NodeIdentIFace* _node)
+{
+    return const_cast<SymbolNodeIFace*>(symbol_cast(const_cast<const NodeIdentIFace*>(_node)));
+}
+
 } }
 
 #endif
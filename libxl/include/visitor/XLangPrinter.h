@@ -20,6 +20,7 @@
 
 #include "node/XLangNodeIFace.h" // node::NodeIdentIFace
 #include "visitor/XLangVisitor.h" // visitor::VisitorDFS
+#include "visitor/XLangStaticVisitor.h" // visitor::StaticVisitor
 
 namespace xl { namespace visitor {
 
@@ -65,7 +66,7 @@ private:
     size_t m_bfs_index;
 };
 
-class IndentedLispPrinter : public VisitorDFS
+class IndentedLispPrinter : public StaticVisitor<IndentedLispPrinter>
 {
 public:
     IndentedLispPrinter() : m_depth(0)
@@ -77,16 +78,12 @@ public:
     void visit(const node::TermNodeIFace<node::NodeIdentIFace::CHAR>*   _node);
     void visit(const node::TermNodeIFace<node::NodeIdentIFace::IDENT>*  _node);
     void visit_null();
-    bool is_printer() const
-    {
-        return true;
-    }
 
 private:
     size_t m_depth;
 };
 
-class LispPrinter : public VisitorDFS
+class LispPrinter : public StaticVisitor<LispPrinter>
 {
 public:
     LispPrinter() : m_depth(0)
@@ -98,16 +95,12 @@ public:
     void visit(const node::TermNodeIFace<node::NodeIdentIFace::CHAR>*   _node);
     void visit(const node::TermNodeIFace<node::NodeIdentIFace::IDENT>*  _node);
     void visit_null();
-    bool is_printer() const
-    {
-        return true;
-    }
 
 private:
     size_t m_depth;
 };
 
-struct XMLPrinter : public VisitorDFS
+struct XMLPrinter : public StaticVisitor<XMLPrinter>
 {
 public:
     XMLPrinter() : m_depth(0)
@@ -119,16 +112,12 @@ public:
     void visit(const node::TermNodeIFace<node::NodeIdentIFace::CHAR>*   _node);
     void visit(const node::TermNodeIFace<node::NodeIdentIFace::IDENT>*  _node);
     void visit_null();
-    bool is_printer() const
-    {
-        return true;
-    }
 
 private:
     size_t m_depth;
 };
 
-struct DotPrinter : public VisitorDFS
+struct DotPrinter : public StaticVisitor<DotPrinter>
 {
 public:
     DotPrinter(bool horizontal = false, bool print_digraph_block = true)
@@ -143,16 +132,17 @@ public:
     void visit_null();
     static std::string print_header(bool horizontal);
     static std::string print_footer();
-    bool is_printer() const
-    {
-        return true;
-    }
 
 private:
     bool m_horizontal;
     bool m_print_digraph_block;
 };
 
+extern template class StaticVisitor<IndentedLispPrinter>;
+extern template class StaticVisitor<LispPrinter>;
+extern template class StaticVisitor<XMLPrinter>;
+extern template class StaticVisitor<DotPrinter>;
+
 } }
 
 #endif
@@ -0,0 +1,129 @@
+// XLang
+// -- A minimum viable English parser implemented in LexYacc
+// Copyright (C) 2011 onlyuser <mailto:onlyuser@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef XLANG_STATIC_VISITOR_H_
+#define XLANG_STATIC_VISITOR_H_
+
+#include "node/XLangNodeIFace.h" // node::NodeIdentIFace
+#include "visitor/XLangFilterable.h" // visitor::Filterable
+#include "XLangString.h" // xl::escape
+#include <sstream> // std::stringstream
+
+namespace xl { namespace visitor {
+
+// Depth-first visitor with compile-time dispatch. Derived supplies the visit
+// overloads it cares about (pulling in the rest with a using-declaration);
+// dispatch_visit picks the overload from the node's type tag and calls it
+// directly, with no virtual call and no dynamic_cast.
+template<class Derived>
+class StaticVisitor : public Filterable
+{
+public:
+    std::stringstream m_output_ss;
+
+    StaticVisitor() : m_allow_visit_null(true)
+    {}
+
+    void visit(const node::TermNodeIFace<node::NodeIdentIFace::INT>* _node)
+    {
+        m_output_ss << _node->value();
+    }
+    void visit(const node::TermNodeIFace<node::NodeIdentIFace::FLOAT>* _node)
+    {
+        m_output_ss << _node->value();
+    }
+    void visit(const node::TermNodeIFace<node::NodeIdentIFace::STRING>* _node)
+    {
+        m_output_ss << '\"' << xl::escape(*_node->value()) << '\"';
+    }
+    void visit(const node::TermNodeIFace<node::NodeIdentIFace::CHAR>* _node)
+    {
+        m_output_ss << '\'' << xl::escape(_node->value()) << '\'';
+    }
+    void visit(const node::TermNodeIFace<node::NodeIdentIFace::IDENT>* _node)
+    {
+        m_output_ss << *_node->value();
+    }
+    void visit(const node::SymbolNodeIFace* _node)
+    {
+        if(m_filter_cb) {
+            if(_node->is_root() && !m_filter_cb(_node)) {
+                return;
+            }
+        }
+        for(size_t i = 0; i < _node->size(); i++) {
+            const node::NodeIdentIFace* child = (*_node)[i];
+            if(m_filter_cb) {
+                if(child && child->type() == node::NodeIdentIFace::SYMBOL && !m_filter_cb(child)) {
+                    StaticVisitor::visit(static_cast<const node::SymbolNodeIFace*>(child->iface()));
+                    continue;
+                }
+            }
+            dispatch_visit(child);
+        }
+    }
+    void visit_null()
+    {
+        m_output_ss << "NULL";
+    }
+    void dispatch_visit(const node::NodeIdentIFace* unknown)
+    {
+        Derived* self = static_cast<Derived*>(this);
+        if(!unknown) {
+            if(m_allow_visit_null) {
+                self->visit_null();
+            }
+            return;
+        }
+        switch(unknown->type()) {
+            case node::NodeIdentIFace::INT:
+                self->visit(static_cast<const node::TermNodeIFace<node::NodeIdentIFace::INT>*>(unknown->iface()));
+                break;
+            case node::NodeIdentIFace::FLOAT:
+                self->visit(static_cast<const node::TermNodeIFace<node::NodeIdentIFace::FLOAT>*>(unknown->iface()));
+                break;
+            case node::NodeIdentIFace::STRING:
+                self->visit(static_cast<const node::TermNodeIFace<node::NodeIdentIFace::STRING>*>(unknown->iface()));
+                break;
+            case node::NodeIdentIFace::CHAR:
+                self->visit(static_cast<const node::TermNodeIFace<node::NodeIdentIFace::CHAR>*>(unknown->iface()));
+                break;
+            case node::NodeIdentIFace::IDENT:
+                self->visit(static_cast<const node::TermNodeIFace<node::NodeIdentIFace::IDENT>*>(unknown->iface()));
+                break;
+            case node::NodeIdentIFace::SYMBOL:
+                self->visit(static_cast<const node::SymbolNodeIFace*>(unknown->iface()));
+                break;
+            default:
+                m_output_ss << "unknown node type" << std::endl;
+                break;
+        }
+    }
+
+    // optional
+    void set_allow_visit_null(bool allow_visit_null)
+    {
+        m_allow_visit_null = allow_visit_null;
+    }
+
+private:
+    bool m_allow_visit_null;
+};
+
+} }
+
+#endif
@@ -24,7 +24,7 @@
 
 namespace xl {
 
-MemChunk::MemChunk(size_t _size_bytes, std::string _filename, size_t _line_number, dtor_cb_t dtor_cb)
+MemChunk::MemChunk(size_t _size_bytes, const char* _filename, size_t _line_number, dtor_cb_t dtor_cb)
     : m_size_bytes(_size_bytes), m_filename(_filename), m_line_number(_line_number), m_dtor_cb(dtor_cb)
 {
     m_ptr = malloc(_size_bytes);
@@ -40,15 +40,40 @@ MemChunk::~MemChunk()
     }
 }
 
-std::string MemChunk::dump(std::string indent) const
+std::string MemChunk::dump(const std::string &indent) const
 {
     std::stringstream output_ss;
     output_ss << indent << m_filename << ":" << m_line_number << " .. " << m_size_bytes << " bytes";
     return output_ss.str();
 }
 
-Allocator::Allocator(std::string name)
-    : m_name(name), m_size_bytes(0)
+MemBudget::MemBudget(size_t _limit_bytes, MemBudget* parent)
+    : m_limit_bytes(_limit_bytes), m_parent(parent), m_used_bytes(0), m_peak_bytes(0)
+{
+}
+
+bool MemBudget::charge(size_t size_bytes)
+{
+    size_t used_bytes = m_used_bytes.fetch_add(size_bytes) + size_bytes;
+    if((m_limit_bytes && used_bytes > m_limit_bytes) || (m_parent && !m_parent->charge(size_bytes)))
+    {
+        m_used_bytes.fetch_sub(size_bytes);
+        return false;
+    }
+    size_t peak_bytes = m_peak_bytes.load();
+    while(used_bytes > peak_bytes && !m_peak_bytes.compare_exchange_weak(peak_bytes, used_bytes));
+    return true;
+}
+
+void MemBudget::refund(size_t size_bytes)
+{
+    m_used_bytes.fetch_sub(size_bytes);
+    if(m_parent)
+        m_parent->refund(size_bytes);
+}
+
+Allocator::Allocator(const std::string &name)
+    : m_name(name), m_size_bytes(0), m_budget(NULL)
 {
 }
 Allocator::~Allocator()
@@ -56,10 +81,23 @@ Allocator::~Allocator()
     _free();
 }
 
-void* Allocator::_malloc(size_t size_bytes, std::string filename, size_t line_number,
+void* Allocator::_malloc(size_t size_bytes, const char* filename, size_t line_number,
         MemChunk::dtor_cb_t dtor_cb)
 {
-    MemChunk* chunk = new MemChunk(size_bytes, filename, line_number, dtor_cb);
+    if(m_budget && !m_budget->charge(size_bytes))
+        throw ERROR_MEM_BUDGET_EXCEEDED;
+    MemChunk* chunk = NULL;
+    try
+    {
+        chunk = new MemChunk(size_bytes, filename, line_number, dtor_cb);
+    }
+    catch(...)
+    {
+        // the charge above must not outlive a failed allocation
+        if(m_budget)
+            m_budget->refund(size_bytes);
+        throw;
+    }
     m_size_bytes += size_bytes;
     m_chunk_map.insert(internal_type_t::value_type(chunk->ptr(), chunk));
     return chunk->ptr();
@@ -72,6 +110,8 @@ void Allocator::_free(void* ptr)
     {
         MemChunk* chunk = (*p).second;
         m_size_bytes -= chunk->size();
+        if(m_budget)
+            m_budget->refund(chunk->size());
         delete chunk;
     }
     m_chunk_map.erase(p);
@@ -82,9 +122,12 @@ void Allocator::_free()
     for(auto p = m_chunk_map.begin(); p != m_chunk_map.end(); ++p)
         delete (*p).second;
     m_chunk_map.clear();
+    if(m_budget)
+        m_budget->refund(m_size_bytes);
+    m_size_bytes = 0;
 }
 
-std::string Allocator::dump(std::string indent) const
+std::string Allocator::dump(const std::string &indent) const
 {
     std::stringstream output_ss;
     output_ss << '\"' << m_name << "\" {" << std::endl;
@@ -97,13 +140,13 @@ std::string Allocator::dump(std::string indent) const
 
 }
 
-void* operator new(size_t size_bytes, xl::Allocator &alloc, std::string filename, size_t line_number,
+void* operator new(size_t size_bytes, xl::Allocator &alloc, const char* filename, size_t line_number,
         xl::MemChunk::dtor_cb_t dtor_cb)
 {
     return alloc._malloc(size_bytes, filename, line_number, dtor_cb);
 }
 
-void* operator new(size_t size_bytes, xl::Allocator &alloc, std::string filename, size_t line_number)
+void* operator new(size_t size_bytes, xl::Allocator &alloc, const char* filename, size_t line_number)
 {
     return alloc._malloc(size_bytes, filename, line_number, NULL);
 }
@@ -0,0 +1,131 @@
+// XLang
+// -- A minimum viable English parser implemented in LexYacc
+// Copyright (C) 2011 onlyuser <mailto:onlyuser@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "XLangConsContext.h" // ConsContext
+#include "mvc/XLangMVCModel.h" // mvc::MVCModel
+#include "node/XLangNodeIFace.h" // node::NodeIdentIFace
+#include "node/XLangNode.h" // node::SymbolNode
+#include <string> // std::string
+#include <sstream> // std::stringstream
+#include <iomanip> // std::setprecision
+
+namespace xl {
+
+ConsContext::~ConsContext()
+{
+    if(alloc().budget())
+        alloc().budget()->refund(m_index_bytes);
+}
+
+bool ConsContext::cons_key_t::operator<(const cons_key_t &other) const
+{
+    if(m_type != other.m_type)
+        return m_type<other.m_type;
+    if(m_lexer_id != other.m_lexer_id)
+        return m_lexer_id<other.m_lexer_id;
+    if(m_value != other.m_value)
+        return m_value<other.m_value;
+    return m_child_vec<other.m_child_vec;
+}
+
+node::NodeIdentIFace* ConsContext::intern(const node::NodeIdentIFace* _node)
+{
+    if(!_node)
+        return NULL;
+    cons_key_t key;
+    key.m_type     = _node->type();
+    key.m_lexer_id = _node->lexer_id();
+    std::stringstream ss;
+    switch(_node->type())
+    {
+        case node::NodeIdentIFace::INT:
+            ss << node::term_cast<node::NodeIdentIFace::INT>(_node)->value();
+            break;
+        case node::NodeIdentIFace::FLOAT:
+            ss << std::setprecision(9) << node::term_cast<node::NodeIdentIFace::FLOAT>(_node)->value();
+            break;
+        case node::NodeIdentIFace::STRING:
+            ss << *node::term_cast<node::NodeIdentIFace::STRING>(_node)->value();
+            break;
+        case node::NodeIdentIFace::CHAR:
+            ss << node::term_cast<node::NodeIdentIFace::CHAR>(_node)->value();
+            break;
+        case node::NodeIdentIFace::IDENT:
+            ss << *node::term_cast<node::NodeIdentIFace::IDENT>(_node)->value();
+            break;
+        case node::NodeIdentIFace::SYMBOL:
+            {
+                const node::SymbolNodeIFace* symbol = node::symbol_cast(_node);
+                for(size_t i = 0; i<symbol->size(); i++)
+                    key.m_child_vec.push_back(intern((*symbol)[i]));
+            }
+            break;
+    }
+    key.m_value = ss.str();
+    auto p = m_cons_map.find(key);
+    if(p != m_cons_map.end())
+    {
+        m_shared_count++;
+        m_shared_bytes += (*p).second.m_size_bytes;
+        return (*p).second.m_node;
+    }
+    size_t size_bytes = alloc().size();
+    cons_entry_t entry;
+    entry.m_node       = make_copy(_node, key);
+    entry.m_size_bytes = alloc().size()-size_bytes;
+    m_unique_bytes += entry.m_size_bytes;
+    size_t index_bytes = sizeof(cons_map_t::value_type)+4*sizeof(void*) // payload and tree node links
+            +key.m_value.size()+key.m_child_vec.size()*sizeof(node::NodeIdentIFace*);
+    if(alloc().budget() && !alloc().budget()->charge(index_bytes))
+        throw ERROR_MEM_BUDGET_EXCEEDED;
+    m_index_bytes += index_bytes;
+    m_cons_map.insert(cons_map_t::value_type(key, entry));
+    return entry.m_node;
+}
+
+node::NodeIdentIFace* ConsContext::make_copy(const node::NodeIdentIFace* _node, const cons_key_t &key)
+{
+    uint32_t lexer_id = _node->lexer_id();
+    switch(_node->type())
+    {
+        case node::NodeIdentIFace::INT:
+            return mvc::MVCModel::make_term(this, lexer_id,
+                    node::term_cast<node::NodeIdentIFace::INT>(_node)->value());
+        case node::NodeIdentIFace::FLOAT:
+            return mvc::MVCModel::make_term(this, lexer_id,
+                    node::term_cast<node::NodeIdentIFace::FLOAT>(_node)->value());
+        case node::NodeIdentIFace::STRING:
+            return mvc::MVCModel::make_term(this, lexer_id, alloc_string(key.m_value));
+        case node::NodeIdentIFace::CHAR:
+            return mvc::MVCModel::make_term(this, lexer_id,
+                    node::term_cast<node::NodeIdentIFace::CHAR>(_node)->value());
+        case node::NodeIdentIFace::IDENT:
+            return mvc::MVCModel::make_term(this, lexer_id, alloc_unique_string(key.m_value));
+        case node::NodeIdentIFace::SYMBOL:
+            {
+                // rather than the flattening constructor: keep the shape as is, and
+                // don't re-parent children that other parses already share
+                node::SymbolNode* symbol = mvc::MVCModel::make_symbol(this, lexer_id);
+                for(auto p = key.m_child_vec.begin(); p != key.m_child_vec.end(); ++p)
+                    symbol->push_back_shared(*p);
+                return symbol;
+            }
+    }
+    return NULL;
+}
+
+}
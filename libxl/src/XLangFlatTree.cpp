@@ -0,0 +1,579 @@
+// XLang
+// -- A minimum viable English parser implemented in LexYacc
+// Copyright (C) 2011 onlyuser <mailto:onlyuser@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "node/XLangFlatTree.h" // node::FlatTree
+#include "node/XLangNodeIFace.h" // node::NodeIdentIFace
+#include "node/XLangNode.h" // node::SymbolNode
+#include "XLangAlloc.h" // MemBudget
+#include "XLangHash.h" // hash_combine
+#include "XLangSmallVector.h" // SmallVector
+#include "XLangType.h" // uint32_t
+#include <string> // std::string
+#include <sstream> // std::stringstream
+#include <vector> // std::vector
+#include <deque> // std::deque
+
+// prototype
+extern std::string id_to_name(uint32_t lexer_id);
+
+static std::string ptr_to_string(const void* x)
+{
+    std::stringstream ss;
+    ss << '_' << x;
+    std::string s = ss.str();
+    return s;
+}
+
+namespace xl { namespace node {
+
+const FlatTree::index_t FlatTree::NIL;
+const FlatTree::index_t FlatTree::EOL;
+const uint8_t FlatTree::NULL_SLOT;
+const size_t  FlatTree::SLOT_BYTES;
+
+FlatTree::~FlatTree()
+{
+    if(m_budget)
+        m_budget->refund(size_bytes());
+}
+
+void FlatTree::set_budget(MemBudget* budget)
+{
+    if(m_budget)
+        m_budget->refund(size_bytes());
+    m_budget = NULL;
+    if(budget && !budget->charge(size_bytes()))
+        throw ERROR_MEM_BUDGET_EXCEEDED;
+    m_budget = budget;
+}
+
+void FlatTree::charge(size_t size_bytes)
+{
+    if(m_budget && !m_budget->charge(size_bytes))
+        throw ERROR_MEM_BUDGET_EXCEEDED;
+}
+
+FlatTree::index_t FlatTree::alloc_slot(uint8_t _type, uint32_t lexer_id)
+{
+    charge(SLOT_BYTES);
+    index_t index = m_lexer_id.size();
+    value_t value;
+    value.int_value = 0;
+    m_type.push_back(_type);
+    m_lexer_id.push_back(lexer_id);
+    m_parent.push_back(NIL);
+    m_child_offset.push_back(m_child_vec.size());
+    m_child_count.push_back(0);
+    m_sibling_index.push_back(0);
+    m_value.push_back(value);
+    return index;
+}
+
+// children must be appended while parent_index is the last symbol to take
+// any, so each symbol's run in m_child_vec stays contiguous
+void FlatTree::append_child(index_t parent_index, index_t child_index)
+{
+    charge(sizeof(index_t));
+    m_parent[child_index]        = parent_index;
+    m_sibling_index[child_index] = m_child_count[parent_index];
+    m_child_vec.push_back(child_index);
+    m_child_count[parent_index]++;
+}
+
+// same semantics as the SymbolNode constructor: EOL children are dropped and
+// a child of the same symbol type donates its children (left-recursive lists)
+void FlatTree::adopt_child(index_t parent_index, index_t child_index)
+{
+    if(child_index == EOL)
+        return;
+    if(child_index == NIL)
+    {
+        index_t null_index = alloc_slot(NULL_SLOT, 0);
+        append_child(parent_index, null_index);
+        return;
+    }
+    if(m_type[child_index] == NodeIdentIFace::SYMBOL && m_lexer_id[child_index] == m_lexer_id[parent_index])
+    {
+        // by index: append_child may reallocate m_child_vec under us
+        for(uint32_t i = 0; i<m_child_count[child_index]; i++)
+            append_child(parent_index, m_child_vec[m_child_offset[child_index]+i]);
+        m_garbage_count += 1+m_child_count[child_index]; // the donor's slot and its old run
+        m_child_count[child_index] = 0;
+        return;
+    }
+    append_child(parent_index, child_index);
+}
+
+template<>
+FlatTree::index_t FlatTree::make_term(uint32_t lexer_id, long value)
+{
+    index_t index = alloc_slot(NodeIdentIFace::INT, lexer_id);
+    m_value[index].int_value = value;
+    return index;
+}
+
+template<>
+FlatTree::index_t FlatTree::make_term(uint32_t lexer_id, float32_t value)
+{
+    index_t index = alloc_slot(NodeIdentIFace::FLOAT, lexer_id);
+    m_value[index].float_value = value;
+    return index;
+}
+
+template<>
+FlatTree::index_t FlatTree::make_term(uint32_t lexer_id, std::string* value)
+{
+    index_t index = alloc_slot(NodeIdentIFace::STRING, lexer_id);
+    m_value[index].string_value = value;
+    return index;
+}
+
+template<>
+FlatTree::index_t FlatTree::make_term(uint32_t lexer_id, char value)
+{
+    index_t index = alloc_slot(NodeIdentIFace::CHAR, lexer_id);
+    m_value[index].char_value = value;
+    return index;
+}
+
+template<>
+FlatTree::index_t FlatTree::make_term(uint32_t lexer_id, const std::string* value)
+{
+    index_t index = alloc_slot(NodeIdentIFace::IDENT, lexer_id);
+    m_value[index].ident_value = value;
+    return index;
+}
+
+FlatTree::index_t FlatTree::make_symbol_from_array(uint32_t lexer_id, size_t size, const index_t* children)
+{
+    index_t index = alloc_slot(NodeIdentIFace::SYMBOL, lexer_id);
+    for(size_t i = 0; i<size; i++)
+        adopt_child(index, children[i]);
+    return index;
+}
+
+FlatTree::index_t FlatTree::make_symbol(uint32_t lexer_id, const std::vector<index_t> &vec)
+{
+    return make_symbol_from_array(lexer_id, vec.size(), vec.data());
+}
+
+// same semantics as MVCModel::append_symbol; a list whose run has since been
+// followed by other runs is moved to the end of m_child_vec first
+FlatTree::index_t FlatTree::append_symbol_from_array(uint32_t lexer_id, index_t list, size_t size,
+        const index_t* children)
+{
+    if(list < 0 || m_type[list] != NodeIdentIFace::SYMBOL || m_lexer_id[list] != lexer_id)
+    {
+        SmallVector<index_t, 8> child_vec;
+        child_vec.push_back(list);
+        for(size_t i = 0; i<size; i++)
+            child_vec.push_back(children[i]);
+        return make_symbol_from_array(lexer_id, child_vec.size(), child_vec.begin());
+    }
+    uint32_t offset = m_child_offset[list];
+    uint32_t count  = m_child_count[list];
+    if(offset+count != m_child_vec.size())
+    {
+        charge(count*sizeof(index_t));
+        m_child_offset[list] = m_child_vec.size();
+        for(uint32_t i = 0; i<count; i++)
+            m_child_vec.push_back(m_child_vec[offset+i]); // by index, see adopt_child
+        m_garbage_count += count;
+    }
+    for(size_t i = 0; i<size; i++)
+        adopt_child(list, children[i]);
+    return list;
+}
+
+// copies an existing tree in pre-order, so a depth-first walk of the result
+// reads the slot arrays front to back
+FlatTree::index_t FlatTree::import(const NodeIdentIFace* _node)
+{
+    if(!_node)
+        return alloc_slot(NULL_SLOT, 0);
+    switch(_node->type())
+    {
+        case NodeIdentIFace::INT:
+            return make_term(_node->lexer_id(),
+                    term_cast<NodeIdentIFace::INT>(_node)->value());
+        case NodeIdentIFace::FLOAT:
+            return make_term(_node->lexer_id(),
+                    term_cast<NodeIdentIFace::FLOAT>(_node)->value());
+        case NodeIdentIFace::STRING:
+            return make_term(_node->lexer_id(),
+                    term_cast<NodeIdentIFace::STRING>(_node)->value());
+        case NodeIdentIFace::CHAR:
+            return make_term(_node->lexer_id(),
+                    term_cast<NodeIdentIFace::CHAR>(_node)->value());
+        case NodeIdentIFace::IDENT:
+            return make_term(_node->lexer_id(),
+                    term_cast<NodeIdentIFace::IDENT>(_node)->value());
+        case NodeIdentIFace::SYMBOL:
+            {
+                auto symbol = symbol_cast(_node);
+                index_t index = alloc_slot(NodeIdentIFace::SYMBOL, _node->lexer_id());
+                SmallVector<index_t, 8> child_vec; // the subtrees take their runs first
+                for(size_t i = 0; i<symbol->size(); i++)
+                    child_vec.push_back(import((*symbol)[i]));
+                m_child_offset[index] = m_child_vec.size();
+                for(size_t j = 0; j<child_vec.size(); j++)
+                    append_child(index, child_vec[j]);
+                return index;
+            }
+    }
+    return NIL;
+}
+
+// same walk as import, over another FlatTree
+FlatTree::index_t FlatTree::copy_subtree(const FlatTree &tree, index_t index)
+{
+    if(tree.is_null(index))
+        return alloc_slot(NULL_SLOT, 0);
+    index_t new_index = alloc_slot(tree.m_type[index], tree.m_lexer_id[index]);
+    if(tree.m_type[index] != NodeIdentIFace::SYMBOL)
+    {
+        m_value[new_index] = tree.m_value[index];
+        return new_index;
+    }
+    SmallVector<index_t, 8> child_vec;
+    for(uint32_t i = 0; i<tree.m_child_count[index]; i++)
+        child_vec.push_back(copy_subtree(tree, tree.child(index, i)));
+    m_child_offset[new_index] = m_child_vec.size();
+    for(size_t j = 0; j<child_vec.size(); j++)
+        append_child(new_index, child_vec[j]);
+    return new_index;
+}
+
+void FlatTree::compact()
+{
+    if(!m_garbage_count)
+        return;
+    size_t old_size_bytes = size_bytes();
+    FlatTree tree; // unbudgeted, this tree's charge already covers it
+    if(m_root >= 0)
+        tree.m_root = tree.copy_subtree(*this, m_root);
+    m_type.swap(tree.m_type);
+    m_lexer_id.swap(tree.m_lexer_id);
+    m_parent.swap(tree.m_parent);
+    m_child_offset.swap(tree.m_child_offset);
+    m_child_count.swap(tree.m_child_count);
+    m_sibling_index.swap(tree.m_sibling_index);
+    m_value.swap(tree.m_value);
+    m_child_vec.swap(tree.m_child_vec);
+    if(m_root >= 0)
+        m_root = tree.m_root;
+    m_garbage_count = 0;
+    if(m_budget)
+        m_budget->refund(old_size_bytes-size_bytes());
+}
+
+void FlatTree::reserve(size_t n)
+{
+    m_type.reserve(n);
+    m_lexer_id.reserve(n);
+    m_parent.reserve(n);
+    m_child_offset.reserve(n);
+    m_child_count.reserve(n);
+    m_sibling_index.reserve(n);
+    m_value.reserve(n);
+    m_child_vec.reserve(n); // every slot but the root is one symbol's child
+}
+
+void FlatTree::clear()
+{
+    if(m_budget)
+        m_budget->refund(size_bytes());
+    m_type.clear();
+    m_lexer_id.clear();
+    m_parent.clear();
+    m_child_offset.clear();
+    m_child_count.clear();
+    m_sibling_index.clear();
+    m_value.clear();
+    m_child_vec.clear();
+    m_root = NIL;
+    m_garbage_count = 0;
+}
+
+size_t FlatTree::size_bytes() const
+{
+    return size()*SLOT_BYTES+m_child_vec.size()*sizeof(index_t);
+}
+
+FlatTree::index_t FlatTree::next_sibling(index_t index) const
+{
+    index_t parent_index = m_parent[index];
+    if(parent_index == NIL)
+        return NIL;
+    return child(parent_index, m_sibling_index[index]+1);
+}
+
+//=============================================================================
+// adapter
+
+class FlatNode : virtual public NodeIdentIFace
+{
+public:
+    FlatNode(const FlatTreeView* view, FlatTree::index_t _index)
+        : m_view(view), m_index(_index), m_hash(0), m_depth(-1), m_height(-1), m_bfs_index(-1)
+    {}
+
+    // required
+    NodeIdentIFace::type_t type() const
+    {
+        return m_view->tree().type(m_index);
+    }
+    uint32_t lexer_id() const
+    {
+        return m_view->tree().lexer_id(m_index);
+    }
+    std::string name() const
+    {
+        return id_to_name(lexer_id());
+    }
+    void set_parent(NodeIdentIFace* parent)
+    {} // read-only
+    NodeIdentIFace* parent() const
+    {
+        return m_view->node(m_view->tree().parent(m_index));
+    }
+    std::string uid() const
+    {
+        return ptr_to_string(this);
+    }
+
+    // optional
+    int index() const
+    {
+        const FlatTree &tree = m_view->tree();
+        if(tree.parent(m_index) == FlatTree::NIL)
+            return -1;
+        return tree.sibling_index(m_index);
+    }
+    uint64_t hash() const
+    {
+        if(!m_hash)
+            m_hash = compute_hash(hash_combine(hash_value(static_cast<long>(type())), lexer_id()));
+        return m_hash;
+    }
+
+    // visitation-related
+    void set_depth(int depth)
+    {
+        m_depth = depth;
+    }
+    int depth() const
+    {
+        return m_depth;
+    }
+    void set_height(int height)
+    {
+        m_height = height;
+    }
+    int height() const
+    {
+        return m_height;
+    }
+    void set_bfs_index(int bfs_index)
+    {
+        m_bfs_index = bfs_index;
+    }
+    int bfs_index() const
+    {
+        return m_bfs_index;
+    }
+
+protected:
+    const FlatTreeView* m_view;
+    FlatTree::index_t   m_index;
+    mutable uint64_t    m_hash; // same scheme as Node, computed on first use
+
+    int                 m_depth;
+    int                 m_height;
+    int                 m_bfs_index;
+
+    virtual uint64_t compute_hash(uint64_t seed) const = 0;
+};
+
+template<NodeIdentIFace::type_t _type>
+struct FlatValue;
+template<> struct FlatValue<NodeIdentIFace::INT>
+{
+    static long get(const FlatTree::value_t &v) { return v.int_value; }
+    static bool equal(long a, long b) { return a == b; }
+};
+template<> struct FlatValue<NodeIdentIFace::FLOAT>
+{
+    static float32_t get(const FlatTree::value_t &v) { return v.float_value; }
+    static bool equal(float32_t a, float32_t b) { return a == b; }
+};
+template<> struct FlatValue<NodeIdentIFace::STRING>
+{
+    static std::string* get(const FlatTree::value_t &v) { return v.string_value; }
+    static bool equal(const std::string* a, const std::string* b) { return *a == *b; }
+};
+template<> struct FlatValue<NodeIdentIFace::CHAR>
+{
+    static char get(const FlatTree::value_t &v) { return v.char_value; }
+    static bool equal(char a, char b) { return a == b; }
+};
+template<> struct FlatValue<NodeIdentIFace::IDENT>
+{
+    static const std::string* get(const FlatTree::value_t &v) { return v.ident_value; }
+    static bool equal(const std::string* a, const std::string* b) { return a == b || *a == *b; }
+};
+
+template<NodeIdentIFace::type_t _type>
+class FlatTermNode : public FlatNode, public TermNodeIFace<_type>
+{
+public:
+    FlatTermNode(const FlatTreeView* view, FlatTree::index_t _index)
+        : FlatNode(view, _index)
+    {}
+    typename TermInternalType<_type>::type value() const
+    {
+        return FlatValue<_type>::get(m_view->tree().value(m_index));
+    }
+    bool compare(const NodeIdentIFace* _node) const
+    {
+        if(!is_same_type(_node) || !same_hash(_node))
+            return false;
+        return FlatValue<_type>::equal(value(), term_cast<_type>(_node)->value());
+    }
+
+private:
+    uint64_t compute_hash(uint64_t seed) const
+    {
+        return hash_combine(seed, hash_value(value()));
+    }
+};
+
+class FlatSymbolNode : public FlatNode, public SymbolNodeIFace
+{
+public:
+    FlatSymbolNode(const FlatTreeView* view, FlatTree::index_t _index)
+        : FlatNode(view, _index)
+    {}
+
+    // required
+    NodeIdentIFace* operator[](uint32_t index) const
+    {
+        return m_view->node(m_view->tree().child(m_index, index));
+    }
+    size_t size() const
+    {
+        return m_view->tree().child_count(m_index);
+    }
+
+    // optional
+    bool compare(const NodeIdentIFace* _node) const
+    {
+        if(this == _node)
+            return true;
+        if(!is_same_type(_node) || !same_hash(_node))
+            return false;
+        auto symbol_node = symbol_cast(_node);
+        if(size() != symbol_node->size())
+            return false;
+        for(size_t i = 0; i<size(); i++)
+        {
+            const NodeIdentIFace* child       = (*this)[i];
+            const NodeIdentIFace* other_child = (*symbol_node)[i];
+            if(!child || !other_child)
+            {
+                if(child != other_child)
+                    return false;
+                continue;
+            }
+            if(!child->compare(other_child))
+                return false;
+        }
+        return true;
+    }
+
+private:
+    uint64_t compute_hash(uint64_t seed) const
+    {
+        for(size_t i = 0; i<size(); i++)
+        {
+            const NodeIdentIFace* child = (*this)[i];
+            seed = hash_combine(seed, child ? child->hash() : 0);
+        }
+        return seed;
+    }
+};
+
+struct FlatTreeView::proxy_pool_t
+{
+    std::deque<FlatTermNode<NodeIdentIFace::INT> >    m_int_pool; // deque: proxies never move
+    std::deque<FlatTermNode<NodeIdentIFace::FLOAT> >  m_float_pool;
+    std::deque<FlatTermNode<NodeIdentIFace::STRING> > m_string_pool;
+    std::deque<FlatTermNode<NodeIdentIFace::CHAR> >   m_char_pool;
+    std::deque<FlatTermNode<NodeIdentIFace::IDENT> >  m_ident_pool;
+    std::deque<FlatSymbolNode>                        m_symbol_pool;
+};
+
+FlatTreeView::FlatTreeView(const FlatTree &tree)
+    : m_tree(tree), m_proxy_pool(new proxy_pool_t)
+{}
+
+FlatTreeView::~FlatTreeView()
+{
+    delete m_proxy_pool;
+}
+
+NodeIdentIFace* FlatTreeView::node(FlatTree::index_t index) const
+{
+    if(index < 0 || m_tree.is_null(index))
+        return NULL;
+    if(m_proxy_vec.size() < m_tree.size())
+        m_proxy_vec.resize(m_tree.size(), NULL);
+    if(m_proxy_vec[index])
+        return m_proxy_vec[index];
+    NodeIdentIFace* proxy = NULL;
+    switch(m_tree.type(index))
+    {
+        case NodeIdentIFace::INT:
+            m_proxy_pool->m_int_pool.push_back(FlatTermNode<NodeIdentIFace::INT>(this, index));
+            proxy = &m_proxy_pool->m_int_pool.back();
+            break;
+        case NodeIdentIFace::FLOAT:
+            m_proxy_pool->m_float_pool.push_back(FlatTermNode<NodeIdentIFace::FLOAT>(this, index));
+            proxy = &m_proxy_pool->m_float_pool.back();
+            break;
+        case NodeIdentIFace::STRING:
+            m_proxy_pool->m_string_pool.push_back(FlatTermNode<NodeIdentIFace::STRING>(this, index));
+            proxy = &m_proxy_pool->m_string_pool.back();
+            break;
+        case NodeIdentIFace::CHAR:
+            m_proxy_pool->m_char_pool.push_back(FlatTermNode<NodeIdentIFace::CHAR>(this, index));
+            proxy = &m_proxy_pool->m_char_pool.back();
+            break;
+        case NodeIdentIFace::IDENT:
+            m_proxy_pool->m_ident_pool.push_back(FlatTermNode<NodeIdentIFace::IDENT>(this, index));
+            proxy = &m_proxy_pool->m_ident_pool.back();
+            break;
+        case NodeIdentIFace::SYMBOL:
+            m_proxy_pool->m_symbol_pool.push_back(FlatSymbolNode(this, index));
+            proxy = &m_proxy_pool->m_symbol_pool.back();
+            break;
+    }
+    m_proxy_vec[index] = proxy;
+    return proxy;
+}
+
+} }
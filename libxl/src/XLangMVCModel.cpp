@@ -20,7 +20,6 @@
 #include "node/XLangNode.h" // node::NodeIdentIFace
 #include "XLangString.h" // xl::unescape_xml
 #include "XLangType.h" // uint32_t
-#include <stdarg.h> // va_list
 #include <string> // std::string
 #include <vector> // std::vector
 
@@ -37,16 +36,6 @@
 
 namespace xl { namespace mvc {
 
-node::SymbolNode* MVCModel::make_symbol(TreeContext* tc, uint32_t lexer_id, size_t size, ...)
-{
-    va_list ap;
-    va_start(ap, size);
-    node::SymbolNode* node = new (PNEW(tc->alloc(), node::, NodeIdentIFace))
-            node::SymbolNode(lexer_id, size, ap);
-    va_end(ap);
-    return node;
-}
-
 node::SymbolNode* MVCModel::make_symbol(TreeContext* tc, uint32_t lexer_id, std::vector<node::NodeIdentIFace*>& vec)
 {
     return new (PNEW(tc->alloc(), node::, NodeIdentIFace))
@@ -108,7 +97,7 @@ static node::NodeIdentIFace* _make_ast_from_ticpp(TreeContext* tc, ticpp::Node*
     if(dynamic_cast<ticpp::Document*>(ticpp_node))
     {
         uint32_t lexer_id = 0;
-        node::SymbolNode* document_node = mvc::MVCModel::make_symbol(tc, lexer_id, 0);
+        node::SymbolNode* document_node = mvc::MVCModel::make_symbol(tc, lexer_id);
         if(ticpp_node->NoChildren())
             return document_node;
         ticpp::Iterator<ticpp::Node> p;
@@ -158,7 +147,7 @@ static node::NodeIdentIFace* _make_ast_from_ticpp(TreeContext* tc, ticpp::Node*
             return term_node;
         else
         {
-            node::SymbolNode* symbol_node = mvc::MVCModel::make_symbol(tc, lexer_id, 0);
+            node::SymbolNode* symbol_node = mvc::MVCModel::make_symbol(tc, lexer_id);
             ticpp::Iterator<ticpp::Node> r;
             for(r = r.begin(ticpp_node); r != r.end(); r++)
                 symbol_node->push_back(_make_ast_from_ticpp(tc, r.Get()));
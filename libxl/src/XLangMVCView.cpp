@@ -19,18 +19,17 @@
 #include "node/XLangNodeIFace.h" // node::NodeIdentIFace
 #include "visitor/XLangPrinter.h" // visitor::LispPrinter
 #include "XLangType.h" // uint32_t
-#include <string.h> // strlen
 #include <string> // std::string
 #include <iostream> // std::cout
 #include <sstream> // std::stringstream
+#include <vector> // std::vector
 
 /* source code courtesy of Frank Thomas Braun */
 /* minimally altered by onlyuser <mailto:onlyuser@gmail.com> */
 
 /* calc3d.c: Generation of the graph of the syntax tree */
 
-#include <stdio.h> // printf
-#include <string> // strcpy
+#include <stdio.h> // snprintf
 
 //#include "calc3.h"
 //#include "calc3.tab.h"
@@ -46,7 +45,7 @@ void MVCView::annotate_tree(const node::NodeIdentIFace*            _node,
 {
     if(bfs) {
         // BFS traversal
-        auto symbol = dynamic_cast<const node::SymbolNodeIFace*>(_node);
+        auto symbol = node::symbol_cast(_node);
         if(!symbol) {
             return;
         }
@@ -122,36 +121,61 @@ std::string MVCView::print_dot_footer()
 }
 
 typedef const node::NodeIdentIFace nodeType;
-std::string ex(nodeType *p);
-std::string MVCView::print_graph(nodeType* p)
+
+/* ASCII-Graphic for one print_graph call, sized to the tree before drawing */
+struct graph_canvas_t
+{
+    std::vector<std::string> m_lines;
+};
+
+/* pass 1 result for one node, kept in a side array in pre-order; columns
+ * are relative to the node's start column c */
+struct graph_layout_t
+{
+    std::string m_text;  /* node text */
+    int         m_width; /* ce - c */
+    int         m_mid;   /* cm - c */
+    int         m_bar;   /* cbar - c */
+};
+
+static std::string ex(nodeType *p, size_t graph_number);
+std::string MVCView::print_graph(nodeType* p, size_t graph_number)
 {
     std::stringstream output;
-    output << ex(p) << std::endl;
+    output << ex(p, graph_number) << std::endl;
     return output.str();
 }
 
-int del = 1; /* distance of graph columns */
-int eps = 3; /* distance of graph lines */
+static const int del = 1; /* distance of graph columns */
+static const int eps = 3; /* distance of graph lines */
 
 /* interface for drawing (can be replaced by "real" graphic using GD or other) */
-void graphInit (void);
-std::string graphFinish();
-void graphBox (char *s, int *w, int *h);
-void graphDrawBox (char *s, int c, int l);
-void graphDrawArrow (int c1, int l1, int c2, int l2);
+static void graphInit (graph_canvas_t* canvas, int lines, int columns);
+static std::string graphFinish(graph_canvas_t* canvas, size_t graph_number);
+static void graphBox (const std::string &s, int *w, int *h);
+static void graphDrawBox (graph_canvas_t* canvas, const std::string &s, int c, int l);
+static void graphDrawArrow (graph_canvas_t* canvas, int c1, int l1, int c2, int l2);
 
-/* recursive drawing of the syntax tree */
-void exNode (nodeType *p, int c, int l, int *ce, int *cm);
+/* two passes over the syntax tree: widths bottom-up, then drawing top-down */
+static int layoutNode (std::vector<graph_layout_t>* layouts, nodeType *p, int l, int *lmax);
+static void drawNode (graph_canvas_t* canvas, const std::vector<graph_layout_t> &layouts, size_t *index,
+        nodeType *p, int c, int l);
 
 /*****************************************************************************/
 
 /* main entry point of the manipulation of the syntax tree */
-std::string ex (nodeType *p) {
-    int rte, rtm;
-
-    graphInit ();
-    exNode (p, 0, 0, &rte, &rtm);
-    return graphFinish();
+static std::string ex (nodeType *p, size_t graph_number) {
+    graph_canvas_t canvas;
+    std::vector<graph_layout_t> layouts;
+    size_t index = 0;
+    int lmax = 0;
+
+    if(p) {
+        layoutNode (&layouts, p, 0, &lmax);
+        graphInit (&canvas, lmax + 1, layouts[0].m_width);
+        drawNode (&canvas, layouts, &index, p, 0, 0);
+    }
+    return graphFinish(&canvas, graph_number);
 }
 
 /*c----cm---ce---->                       drawing of term-nodes
@@ -170,161 +194,155 @@ std::string ex (nodeType *p) {
  *
  */
 
-void exNode
-    (   nodeType *p,
-        int c, int l,        /* start column and line of node */
-        int *ce, int *cm     /* resulting end column and mid of node */
-    )
-{
-    int w, h;           /* node width and height */
-    char *s;            /* node text */
-    int cbar;           /* "real" start column of node (centred above subnodes) */
-    uint32_t k;              /* child number */
-    int che, chm;       /* end column and mid of children */
-    int cs;             /* start column of children */
-    //char word[20];      /* extended node text */
-    char word[80];      /* extended node text */
-
-    if(!p) return;
+static std::string graphNodeText (nodeType *p) {
+    char word[32]; /* formatted number */
 
-    strcpy (word, "???"); /* should never appear */
-    s = word;
-    std::string temp;
     switch(p->type()) {
         case node::NodeIdentIFace::INT:
-            sprintf(word, "%ld", dynamic_cast<const node::TermNodeIFace<node::NodeIdentIFace::INT>*>(p)->value());
-            break;
+            snprintf(word, sizeof(word), "%ld", node::term_cast<node::NodeIdentIFace::INT>(p)->value());
+            return word;
         case node::NodeIdentIFace::FLOAT:
-            sprintf(word, "%f", dynamic_cast<const node::TermNodeIFace<node::NodeIdentIFace::FLOAT>*>(p)->value());
-            break;
+            snprintf(word, sizeof(word), "%f", node::term_cast<node::NodeIdentIFace::FLOAT>(p)->value());
+            return word;
         case node::NodeIdentIFace::STRING:
-            sprintf(word, "\"%s\"", dynamic_cast<const node::TermNodeIFace<node::NodeIdentIFace::STRING>*>(p)->value()->c_str());
-            break;
+            return "\"" + *node::term_cast<node::NodeIdentIFace::STRING>(p)->value() + "\"";
         case typeId:
-            sprintf(word, "%s", dynamic_cast<const node::TermNodeIFace<node::NodeIdentIFace::IDENT>*>(p)->value()->c_str());
-            break;
+            return *node::term_cast<node::NodeIdentIFace::IDENT>(p)->value();
         case typeOpr:
-            temp = p->name();
-            s = const_cast<char*>(temp.c_str());
-            break;
+            return p->name();
         default:
-            break;
+            return "???"; /* should never appear */
     }
+}
+
+/* pass 1: appends p's layout, then its subtrees'; returns p's index */
+static int layoutNode
+    (   std::vector<graph_layout_t>* layouts,
+        nodeType *p,
+        int l,               /* line of node */
+        int *lmax            /* resulting last line of the tree */
+    )
+{
+    int index;          /* p's slot in layouts */
+    int w, h;           /* node width and height */
+    std::string s;      /* node text */
+    uint32_t k;         /* child number */
+    int che;            /* end column of children */
+
+    index = layouts->size();
+    layouts->push_back(graph_layout_t());
+    if(*lmax < l) *lmax = l;
 
     /* construct node text box */
+    s = graphNodeText (p);
     graphBox (s, &w, &h);
-    cbar = c;
-    *ce = c + w;
-    *cm = c + w / 2;
-
-    /* node is term */
-    if(p->type() != typeOpr ||
-            dynamic_cast<const node::SymbolNodeIFace*>(p)->size() == 0) {
-        graphDrawBox (s, cbar, l);
-        return;
-    }
+    (*layouts)[index].m_width = w;
+    (*layouts)[index].m_mid   = w / 2;
+    (*layouts)[index].m_bar   = 0;
+
+    /* node has children (NULL children take no room) */
+    if(p->type() == typeOpr) {
+        che = 0;
+        for(k = 0; k < node::symbol_cast(p)->size(); k++) {
+            nodeType *child = node::symbol_cast(p)->operator[](k);
+            if(child) {
+                che += (*layouts)[layoutNode (layouts, child, l+h+eps, lmax)].m_width;
+            }
+        }
 
-    /* node has children */
-    cs = c;
-    for(k = 0; k < dynamic_cast<const node::SymbolNodeIFace*>(p)->size(); k++) {
-        exNode (dynamic_cast<const node::SymbolNodeIFace*>(p)->operator[](k), cs, l+h+eps, &che, &chm);
-        cs = che;
+        /* total node width */
+        if(w < che) {
+            (*layouts)[index].m_bar   = (che - w) / 2;
+            (*layouts)[index].m_width = che;
+            (*layouts)[index].m_mid   = che / 2;
+        }
     }
+    (*layouts)[index].m_text = s;
+    return index;
+}
 
-    /* total node width */
-    if(w < che - c) {
-        cbar += (che - c - w) / 2;
-        *ce = che;
-        *cm = (c + che) / 2;
-    }
+/* pass 2: draws p at column c, line l, and its subtrees below it */
+static void drawNode
+    (   graph_canvas_t* canvas,
+        const std::vector<graph_layout_t> &layouts,
+        size_t *index,       /* p's slot in layouts, advanced past its subtree */
+        nodeType *p,
+        int c, int l         /* start column and line of node */
+    )
+{
+    const graph_layout_t &layout = layouts[(*index)++];
+    int w, h;           /* node width and height */
+    uint32_t k;         /* child number */
+    int cs;             /* start column of children */
 
     /* draw node */
-    graphDrawBox (s, cbar, l);
+    graphBox (layout.m_text, &w, &h);
+    graphDrawBox (canvas, layout.m_text, c + layout.m_bar, l);
 
-    /* draw arrows (not optimal: children are drawn a second time) */
+    /* node is term */
+    if(p->type() != typeOpr) {
+        return;
+    }
+
+    /* draw children and arrows */
     cs = c;
-    for(k = 0; k < dynamic_cast<const node::SymbolNodeIFace*>(p)->size(); k++) {
-        exNode (dynamic_cast<const node::SymbolNodeIFace*>(p)->operator[](k), cs, l+h+eps, &che, &chm);
-        graphDrawArrow (*cm, l+h, chm, l+h+eps-1);
-        cs = che;
+    for(k = 0; k < node::symbol_cast(p)->size(); k++) {
+        nodeType *child = node::symbol_cast(p)->operator[](k);
+        if(!child) {
+            continue;
+        }
+        const graph_layout_t &child_layout = layouts[*index];
+        drawNode (canvas, layouts, index, child, cs, l+h+eps);
+        graphDrawArrow (canvas, c + layout.m_mid, l+h, cs + child_layout.m_mid, l+h+eps-1);
+        cs += child_layout.m_width;
     }
 }
 
 /* interface for drawing */
 
-#define lmax 200
-#define cmax 200
-
-char graph[lmax][cmax]; /* array for ASCII-Graphic */
-int graphNumber = 0;
-char buf[cmax];
-
-std::string graphTest (int l, int c)
-{   int ok;
-    ok = 1;
-    if(l < 0) ok = 0;
-    if(l >= lmax) ok = 0;
-    if(c < 0) ok = 0;
-    if(c >= cmax) ok = 0;
-    if(ok) return "";
-    sprintf (buf, "\n+++error: l=%d, c=%d not in drawing rectangle 0, 0 ... %d, %d",
-        l, c, lmax, cmax);
-    return buf;
-    //exit (1);
+static void graphInit (graph_canvas_t* canvas, int lines, int columns) {
+    canvas->m_lines.assign(lines, std::string(columns, ' '));
 }
 
-void graphInit (void) {
-    int i, j;
-    for(i = 0; i < lmax; i++) {
-        for(j = 0; j < cmax; j++) {
-            graph[i][j] = ' ';
-        }
-    }
-}
-
-std::string graphFinish() {
+static std::string graphFinish(graph_canvas_t* canvas, size_t graph_number) {
     std::stringstream ss;
-    int i, j;
-    for(i = 0; i < lmax; i++) {
-        for(j = cmax-1; j > 0 && graph[i][j] == ' '; j--);
-        graph[i][cmax-1] = 0;
-        if(j < cmax-1) graph[i][j+1] = 0;
-        if(graph[i][j] == ' ') graph[i][j] = 0;
+    std::vector<std::string> &lines = canvas->m_lines;
+    size_t i, n;
+    for(i = 0; i < lines.size(); i++) {
+        size_t j = lines[i].find_last_not_of(' ');
+        lines[i].resize(j == std::string::npos ? 0 : j+1);
+    }
+    for(n = lines.size(); n > 1 && lines[n-1].empty(); n--);
+    ss << "\n\nGraph " << graph_number << ":\n";
+    if(!n) {
+        ss << "\n";
     }
-    for(i = lmax-1; i > 0 && graph[i][0] == 0; i--);
-    sprintf (buf, "\n\nGraph %d:\n", graphNumber++);
-    ss << buf;
-    for(j = 0; j <= i; j++) {
-        sprintf (buf, "\n%s", graph[j]);
-        ss << buf;
+    for(i = 0; i < n; i++) {
+        ss << "\n" << lines[i];
     }
-    sprintf(buf, "\n");
-    ss << buf;
+    ss << "\n";
     return ss.str();
 }
 
-void graphBox (char *s, int *w, int *h) {
-    *w = strlen (s) + del;
+static void graphBox (const std::string &s, int *w, int *h) {
+    *w = s.length() + del;
     *h = 1;
 }
 
-void graphDrawBox (char *s, int c, int l) {
+static void graphDrawBox (graph_canvas_t* canvas, const std::string &s, int c, int l) {
     size_t i;
-    graphTest (l, c+strlen(s)-1+del);
-    for(i = 0; i < strlen (s); i++) {
-        graph[l][c+i+del] = s[i];
+    for(i = 0; i < s.length(); i++) {
+        canvas->m_lines[l][c+i+del] = s[i];
     }
 }
 
-void graphDrawArrow (int c1, int l1, int c2, int l2) {
+static void graphDrawArrow (graph_canvas_t* canvas, int c1, int l1, int c2, int l2) {
     int m;
-    graphTest (l1, c1);
-    graphTest (l2, c2);
     m = (l1 + l2) / 2;
-    while(l1 != m) { graph[l1][c1] = '|'; if(l1 < l2) l1++; else l1--; }
-    while(c1 != c2) { graph[l1][c1] = '-'; if(c1 < c2) c1++; else c1--; }
-    while(l1 != l2) { graph[l1][c1] = '|'; if(l1 < l2) l1++; else l1--; }
-    graph[l1][c1] = '|';
+    while(l1 != m) { canvas->m_lines[l1][c1] = '|'; if(l1 < l2) l1++; else l1--; }
+    while(c1 != c2) { canvas->m_lines[l1][c1] = '-'; if(c1 < c2) c1++; else c1--; }
+    while(l1 != l2) { canvas->m_lines[l1][c1] = '|'; if(l1 < l2) l1++; else l1--; }
+    canvas->m_lines[l1][c1] = '|';
 }
 
 } }
@@ -50,27 +50,11 @@ void Node::detach()
     if(!m_parent)
         return;
     xl::node::SymbolNodeIFace* parent_symbol =
-            dynamic_cast<xl::node::SymbolNodeIFace*>(m_parent);
+            xl::node::symbol_cast(m_parent);
     if(parent_symbol)
         parent_symbol->remove_first(this);
 }
 
-int Node::index() const
-{
-    if(!m_parent)
-        return -1;
-    xl::node::SymbolNodeIFace* parent_symbol =
-            dynamic_cast<xl::node::SymbolNodeIFace*>(m_parent);
-    if(!parent_symbol)
-        return -1;
-    for(size_t i = 0; i<parent_symbol->size(); i++)
-    {
-        if((*parent_symbol)[i] == this)
-            return i;
-    }
-    return -1;
-}
-
 template<>
 NodeIdentIFace* TermNode<NodeIdentIFace::STRING>::clone(TreeContext* tc) const
 {
@@ -83,70 +67,62 @@ NodeIdentIFace* TermNode<NodeIdentIFace::STRING>::clone(TreeContext* tc) const
 template<>
 bool TermNode<NodeIdentIFace::STRING>::compare(const NodeIdentIFace* _node) const
 {
-    if(!is_same_type(_node))
+    if(!is_same_type(_node) || !same_hash(_node))
         return false;
-    return *m_value == *dynamic_cast<const TermNode<NodeIdentIFace::STRING>*>(_node)->value();
+    return *m_value == *term_cast<NodeIdentIFace::STRING>(_node)->value();
 }
 
-SymbolNode::SymbolNode(uint32_t _lexer_id, size_t _size, va_list ap)
+// idents are unique per TreeContext only; compare by name across trees
+template<>
+bool TermNode<NodeIdentIFace::IDENT>::compare(const NodeIdentIFace* _node) const
+{
+    if(!is_same_type(_node) || !same_hash(_node))
+        return false;
+    const std::string* value = term_cast<NodeIdentIFace::IDENT>(_node)->value();
+    return m_value == value || *m_value == *value;
+}
+
+SymbolNode::SymbolNode(uint32_t _lexer_id, size_t _size, NodeIdentIFace* const* children)
     : Node(NodeIdentIFace::SYMBOL, _lexer_id)
 {
-    for(size_t i = 0; i<_size; i++)
-    {
-        NodeIdentIFace* child = va_arg(ap, NodeIdentIFace*);
-        if(child == SymbolNode::eol())
-            continue;
-        if(child && is_same_type(child))
-        {
-            SymbolNode* child_symbol = dynamic_cast<SymbolNode*>(child);
-            m_child_vec.insert(m_child_vec.end(),
-                    child_symbol->m_child_vec.begin(),
-                    child_symbol->m_child_vec.end());
-            for(auto p = child_symbol->m_child_vec.begin(); p != child_symbol->m_child_vec.end(); ++p)
-            {
-                if(*p)
-                    (*p)->set_parent(this);
-            }
-            continue;
-        }
-        m_child_vec.push_back(child);
-        if(child)
-            child->set_parent(this);
-    }
+    append(_size, children);
 }
 
 SymbolNode::SymbolNode(uint32_t _lexer_id, std::vector<NodeIdentIFace*>& vec)
     : Node(NodeIdentIFace::SYMBOL, _lexer_id)
 {
-    for(auto q = vec.begin(); q != vec.end(); q++)
+    append(vec.size(), vec.data());
+}
+
+void SymbolNode::append(size_t _size, NodeIdentIFace* const* children)
+{
+    for(size_t i = 0; i<_size; i++)
     {
-        NodeIdentIFace* child = *q;
+        NodeIdentIFace* child = children[i];
         if(child == SymbolNode::eol())
             continue;
         if(child && is_same_type(child))
         {
-            SymbolNode* child_symbol = dynamic_cast<SymbolNode*>(child);
+            SymbolNode* child_symbol = static_cast<SymbolNode*>(symbol_cast(child));
+            size_t index = m_child_vec.size();
             m_child_vec.insert(m_child_vec.end(),
                     child_symbol->m_child_vec.begin(),
                     child_symbol->m_child_vec.end());
-            for(auto p = child_symbol->m_child_vec.begin(); p != child_symbol->m_child_vec.end(); ++p)
-            {
-                if(*p)
-                    (*p)->set_parent(this);
-            }
+            adopt_from(index);
+            rehash_from(index);
             continue;
         }
         m_child_vec.push_back(child);
-        if(child)
-            child->set_parent(this);
+        adopt(m_child_vec.size()-1);
+        rehash_from(m_child_vec.size()-1);
     }
+    rehash_ancestors();
 }
 
 NodeIdentIFace* SymbolNode::clone(TreeContext* tc) const
 {
-    va_list ap;
     SymbolNodeIFace *_clone = new (PNEW(tc->alloc(), , NodeIdentIFace))
-            SymbolNode(m_lexer_id, 0, ap);
+            SymbolNode(m_lexer_id, 0, NULL);
     _clone->set_original(this);
     for(auto p = m_child_vec.begin(); p != m_child_vec.end(); ++p)
     {
@@ -161,47 +137,65 @@ NodeIdentIFace* SymbolNode::clone(TreeContext* tc) const
 void SymbolNode::push_back(NodeIdentIFace* _node)
 {
     m_child_vec.push_back(_node);
-    if(_node)
-        _node->set_parent(this);
+    adopt(m_child_vec.size()-1);
+    rehash_from(m_child_vec.size()-1);
+    rehash_ancestors();
+}
+
+// links a child that other trees may also hold: its parent() and index()
+// are left alone, since no single parent is right for it
+void SymbolNode::push_back_shared(NodeIdentIFace* _node)
+{
+    m_child_vec.push_back(_node);
+    rehash_from(m_child_vec.size()-1);
 }
 
 void SymbolNode::push_front(NodeIdentIFace* _node)
 {
     m_child_vec.insert(m_child_vec.begin(), _node);
-    if(_node)
-        _node->set_parent(this);
+    adopt_from(0);
+    rehash();
+    rehash_ancestors();
 }
 
 void SymbolNode::insert_after(NodeIdentIFace* insert_after_node, NodeIdentIFace* new_node)
 {
-    auto p = std::find(m_child_vec.begin(), m_child_vec.end(), insert_after_node);
+    auto p = locate(insert_after_node);
     if(p == m_child_vec.end())
         return;
     p++;
-    m_child_vec.insert(p, new_node);
-    new_node->set_parent(this);
+    p = m_child_vec.insert(p, new_node);
+    adopt_from(p-m_child_vec.begin());
+    rehash();
+    rehash_ancestors();
 }
 
 void SymbolNode::remove_first(NodeIdentIFace* _node)
 {
-    auto p = std::find(m_child_vec.begin(), m_child_vec.end(), _node);
+    auto p = locate(_node);
     if(p == m_child_vec.end())
         return;
+    size_t index = p-m_child_vec.begin();
     m_child_vec.erase(std::remove(p, m_child_vec.end(), _node), m_child_vec.end());
     if(_node)
         _node->set_parent(NULL);
+    adopt_from(index);
+    rehash();
+    rehash_ancestors();
 }
 
 void SymbolNode::replace_first(NodeIdentIFace* find_node, NodeIdentIFace* replacement_node)
 {
-    auto p = std::find(m_child_vec.begin(), m_child_vec.end(), find_node);
+    auto p = locate(find_node);
     if(p == m_child_vec.end())
         return;
+    size_t index = p-m_child_vec.begin();
     std::replace(p, m_child_vec.end(), find_node, replacement_node);
     if(find_node)
         find_node->set_parent(NULL);
-    if(replacement_node)
-        replacement_node->set_parent(this);
+    adopt(index);
+    rehash();
+    rehash_ancestors();
 }
 
 void SymbolNode::erase(int index)
@@ -209,11 +203,12 @@ void SymbolNode::erase(int index)
     if(index<0 || index >= static_cast<int>(m_child_vec.size()))
         return;
     auto p = m_child_vec.begin()+index;
-    if(p == m_child_vec.end())
-        return;
     if(*p)
         (*p)->set_parent(NULL);
     m_child_vec.erase(p);
+    adopt_from(index);
+    rehash();
+    rehash_ancestors();
 }
 
 NodeIdentIFace* SymbolNode::find_if(bool (*pred)(const NodeIdentIFace* _node)) const
@@ -227,4 +222,58 @@ NodeIdentIFace* SymbolNode::find_if(bool (*pred)(const NodeIdentIFace* _node)) c
     return m_child_vec[index];
 }
 
+void SymbolNode::adopt(size_t index)
+{
+    NodeIdentIFace* child = m_child_vec[index];
+    if(!child)
+        return;
+    child->set_parent(this);
+    child->set_index(index);
+}
+
+// renumber the slots from index on after the vector shifted
+void SymbolNode::adopt_from(size_t index)
+{
+    for(size_t i = index; i<m_child_vec.size(); i++)
+        adopt(i);
+}
+
+// covers this node's own children only; see rehash_ancestors
+void SymbolNode::rehash()
+{
+    m_hash = seed_hash(m_type, m_lexer_id);
+    rehash_from(0);
+}
+
+// fold the children from index on into the hash, in order
+void SymbolNode::rehash_from(size_t index)
+{
+    for(size_t i = index; i<m_child_vec.size(); i++)
+        m_hash = hash_combine(m_hash, m_child_vec[i] ? m_child_vec[i]->hash() : 0);
+}
+
+// a mutated node that already has a parent changes every ancestor's hash;
+// free-standing nodes (the grammar's growing lists) stop at once
+void SymbolNode::rehash_ancestors()
+{
+    for(NodeIdentIFace* p = m_parent; p; p = p->parent())
+    {
+        if(p->type() != NodeIdentIFace::SYMBOL)
+            break;
+        static_cast<SymbolNode*>(symbol_cast(p))->rehash();
+    }
+}
+
+// a child knows its own slot, so only NULL or foreign nodes need a scan
+SymbolNode::child_vec_t::iterator SymbolNode::locate(NodeIdentIFace* _node)
+{
+    if(_node && _node->parent() == this)
+    {
+        int index = _node->index();
+        if(index >= 0 && index<static_cast<int>(m_child_vec.size()) && m_child_vec[index] == _node)
+            return m_child_vec.begin()+index;
+    }
+    return std::find(m_child_vec.begin(), m_child_vec.end(), _node);
+}
+
 } }
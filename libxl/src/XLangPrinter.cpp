@@ -112,7 +112,7 @@ void IndentedLispPrinter::visit(const node::SymbolNodeIFace* _node)
 {
     m_output_ss << std::string(m_depth * 4, ' ') << '(' << _node->name() << std::endl;
     m_depth++;
-    VisitorDFS::visit(_node);
+    StaticVisitor::visit(_node);
     m_depth--;
     m_output_ss << std::string(m_depth * 4, ' ') << ')' << std::endl;
 }
@@ -120,35 +120,35 @@ void IndentedLispPrinter::visit(const node::SymbolNodeIFace* _node)
 void IndentedLispPrinter::visit(const node::TermNodeIFace<node::NodeIdentIFace::INT>* _node)
 {
     m_output_ss << std::string(m_depth * 4, ' ');
-    VisitorDFS::visit(_node);
+    StaticVisitor::visit(_node);
     m_output_ss << std::endl;
 }
 
 void IndentedLispPrinter::visit(const node::TermNodeIFace<node::NodeIdentIFace::FLOAT>* _node)
 {
     m_output_ss << std::string(m_depth * 4, ' ');
-    VisitorDFS::visit(_node);
+    StaticVisitor::visit(_node);
     m_output_ss << std::endl;
 }
 
 void IndentedLispPrinter::visit(const node::TermNodeIFace<node::NodeIdentIFace::STRING>* _node)
 {
     m_output_ss << std::string(m_depth * 4, ' ');
-    VisitorDFS::visit(_node);
+    StaticVisitor::visit(_node);
     m_output_ss << std::endl;
 }
 
 void IndentedLispPrinter::visit(const node::TermNodeIFace<node::NodeIdentIFace::CHAR>* _node)
 {
     m_output_ss << std::string(m_depth * 4, ' ');
-    VisitorDFS::visit(_node);
+    StaticVisitor::visit(_node);
     m_output_ss << std::endl;
 }
 
 void IndentedLispPrinter::visit(const node::TermNodeIFace<node::NodeIdentIFace::IDENT>* _node)
 {
     m_output_ss << std::string(m_depth * 4, ' ');
-    VisitorDFS::visit(_node);
+    StaticVisitor::visit(_node);
     m_output_ss << std::endl;
 }
 
@@ -161,7 +161,7 @@ void LispPrinter::visit(const node::SymbolNodeIFace* _node)
 {
     m_output_ss << '(' << _node->name();
     m_depth++;
-    VisitorDFS::visit(_node);
+    StaticVisitor::visit(_node);
     m_depth--;
     m_output_ss << ')';
     if(m_depth <= 1) {
@@ -172,31 +172,31 @@ void LispPrinter::visit(const node::SymbolNodeIFace* _node)
 void LispPrinter::visit(const node::TermNodeIFace<node::NodeIdentIFace::INT>* _node)
 {
     m_output_ss << " ";
-    VisitorDFS::visit(_node);
+    StaticVisitor::visit(_node);
 }
 
 void LispPrinter::visit(const node::TermNodeIFace<node::NodeIdentIFace::FLOAT>* _node)
 {
     m_output_ss << " ";
-    VisitorDFS::visit(_node);
+    StaticVisitor::visit(_node);
 }
 
 void LispPrinter::visit(const node::TermNodeIFace<node::NodeIdentIFace::STRING>* _node)
 {
     m_output_ss << " ";
-    VisitorDFS::visit(_node);
+    StaticVisitor::visit(_node);
 }
 
 void LispPrinter::visit(const node::TermNodeIFace<node::NodeIdentIFace::CHAR>* _node)
 {
     m_output_ss << " ";
-    VisitorDFS::visit(_node);
+    StaticVisitor::visit(_node);
 }
 
 void LispPrinter::visit(const node::TermNodeIFace<node::NodeIdentIFace::IDENT>* _node)
 {
     m_output_ss << " ";
-    VisitorDFS::visit(_node);
+    StaticVisitor::visit(_node);
 }
 
 void LispPrinter::visit_null()
@@ -212,7 +212,7 @@ void XMLPrinter::visit(const node::SymbolNodeIFace* _node)
 #endif
     m_output_ss << "type=\"" << _node->name() << "\">" << std::endl;
     m_depth++;
-    VisitorDFS::visit(_node);
+    StaticVisitor::visit(_node);
     m_depth--;
     m_output_ss << std::string(m_depth * 4, ' ') << "</symbol>" << std::endl;
 }
@@ -224,7 +224,7 @@ void XMLPrinter::visit(const node::TermNodeIFace<node::NodeIdentIFace::INT>* _no
     m_output_ss << "id=" << _node->uid() << " ";
 #endif
     m_output_ss << "type=\"" << _node->name() << "\" value=";
-    VisitorDFS::visit(_node);
+    StaticVisitor::visit(_node);
     m_output_ss << "/>" << std::endl;
 }
 
@@ -235,7 +235,7 @@ void XMLPrinter::visit(const node::TermNodeIFace<node::NodeIdentIFace::FLOAT>* _
     m_output_ss << "id=" << _node->uid() << " ";
 #endif
     m_output_ss << "type=\"" << _node->name() << "\" value=";
-    VisitorDFS::visit(_node);
+    StaticVisitor::visit(_node);
     m_output_ss << "/>" << std::endl;
 }
 
@@ -257,7 +257,7 @@ void XMLPrinter::visit(const node::TermNodeIFace<node::NodeIdentIFace::CHAR>* _n
     m_output_ss << "id=" << _node->uid() << " ";
 #endif
     m_output_ss << "type=\"" << _node->name() << "\" value=";
-    VisitorDFS::visit(_node);
+    StaticVisitor::visit(_node);
     m_output_ss << "/>" << std::endl;
 }
 
@@ -268,7 +268,7 @@ void XMLPrinter::visit(const node::TermNodeIFace<node::NodeIdentIFace::IDENT>* _
     m_output_ss << "id=" << _node->uid() << " ";
 #endif
     m_output_ss << "type=\"" << _node->name() << "\" value=";
-    VisitorDFS::visit(_node);
+    StaticVisitor::visit(_node);
     m_output_ss << "/>" << std::endl;
 }
 
@@ -286,7 +286,7 @@ void DotPrinter::visit(const node::SymbolNodeIFace* _node)
                 << "\t\tlabel=\"" << _node->name() << "\"," << std::endl
                 << "\t\tshape=\"ellipse\"" << std::endl
                 << "\t];" << std::endl;
-    VisitorDFS::visit(_node);
+    StaticVisitor::visit(_node);
     if(!_node->is_root()) {
         m_output_ss << '\t' << _node->parent()->uid() << "->" << _node->uid() << ";" << std::endl;
     }
@@ -362,4 +362,9 @@ std::string DotPrinter::print_footer()
     return ss.str();
 }
 
+template class StaticVisitor<IndentedLispPrinter>;
+template class StaticVisitor<LispPrinter>;
+template class StaticVisitor<XMLPrinter>;
+template class StaticVisitor<DotPrinter>;
+
 } }
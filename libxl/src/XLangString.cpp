@@ -27,7 +27,7 @@
 
 namespace xl {
 
-bool read_file(std::string filename, std::string &s)
+bool read_file(const std::string &filename, std::string &s)
 {
     FILE* file = fopen(filename.c_str(), "rb");
     if(!file) {
@@ -56,7 +56,7 @@ bool read_file(std::string filename, std::string &s)
     return true;
 }
 
-std::string replace(std::string &s, std::string find_string, std::string replace_string)
+std::string replace(const std::string &s, const std::string &find_string, const std::string &replace_string)
 {
     if(s.empty() || find_string.empty()) {
         return s;
@@ -85,7 +85,7 @@ std::vector<std::string> tokenize(const std::string &s, const char* delim)
     return results;
 }
 
-std::string escape_xml(std::string &s)
+std::string escape_xml(const std::string &s)
 {
     std::string _s(s);
     _s = replace(_s, "&",  "&amp;"); // must replace first
@@ -96,7 +96,7 @@ std::string escape_xml(std::string &s)
     return escape(_s);
 }
 
-std::string unescape_xml(std::string &s)
+std::string unescape_xml(const std::string &s)
 {
     std::string _s(s);
     _s = replace(_s, "&quot;", "\"");
@@ -107,7 +107,7 @@ std::string unescape_xml(std::string &s)
     return unescape(_s);
 }
 
-std::string escape(std::string &s)
+std::string escape(const std::string &s)
 {
     std::stringstream ss;
     for(size_t i = 0; i<s.length(); i++) {
@@ -116,7 +116,7 @@ std::string escape(std::string &s)
     return ss.str();
 }
 
-std::string unescape(std::string &s)
+std::string unescape(const std::string &s)
 {
     char* buf = new char[s.length()+1]; // can't use allocator for arrays
     strcpy(buf, s.c_str());
@@ -166,7 +166,7 @@ char unescape(char c)
     return c;
 }
 
-bool regexp(std::string &s, std::string pattern, std::vector<std::string*> &cap_groups, size_t* start_pos)
+bool regexp(const std::string &s, const std::string &pattern, std::vector<std::string*> &cap_groups, size_t* start_pos)
 {
     int nmatch = cap_groups.size();
     if(!nmatch) {
@@ -176,7 +176,7 @@ bool regexp(std::string &s, std::string pattern, std::vector<std::string*> &cap_
     if(_start_pos >= s.length()) {
         return false;
     }
-    std::string rest = s.substr(_start_pos, s.length()-_start_pos);
+    const char* rest = s.c_str()+_start_pos;
     regex_t preg;
     if(regcomp(&preg, pattern.c_str(), REG_ICASE|REG_EXTENDED)) {
         return false;
@@ -185,7 +185,7 @@ bool regexp(std::string &s, std::string pattern, std::vector<std::string*> &cap_
     if(!pmatch) {
         return false;
     }
-    if(regexec(&preg, rest.c_str(), nmatch, pmatch, 0)) {
+    if(regexec(&preg, rest, nmatch, pmatch, 0)) {
         delete[] pmatch;
         regfree(&preg);
         return false;
@@ -195,7 +195,11 @@ bool regexp(std::string &s, std::string pattern, std::vector<std::string*> &cap_
         if(!cap_groups[i]) {
             continue;
         }
-        *(cap_groups[i]) = rest.substr(pmatch[i].rm_so, pmatch[i].rm_eo-pmatch[i].rm_so);
+        if(pmatch[i].rm_so == -1) {
+            cap_groups[i]->clear();
+            continue;
+        }
+        cap_groups[i]->assign(rest+pmatch[i].rm_so, pmatch[i].rm_eo-pmatch[i].rm_so);
     }
     if(start_pos) {
         *start_pos = _start_pos+pmatch[0].rm_so;
@@ -204,12 +208,12 @@ bool regexp(std::string &s, std::string pattern, std::vector<std::string*> &cap_
     return true;
 }
 
-bool regexp(std::string &s, std::string pattern, std::vector<std::string*> &cap_groups)
+bool regexp(const std::string &s, const std::string &pattern, std::vector<std::string*> &cap_groups)
 {
     return regexp(s, pattern, cap_groups, NULL);
 }
 
-bool regexp(std::string &s, std::string pattern, int nmatch, ...)
+bool regexp(const std::string &s, const std::string &pattern, int nmatch, ...)
 {
     if(!nmatch) {
         return false;
@@ -224,7 +228,7 @@ bool regexp(std::string &s, std::string pattern, int nmatch, ...)
     return regexp(s, pattern, args);
 }
 
-bool regsub(std::string &s, std::string pattern, int nmatch, std::string replace_string)
+bool regsub(std::string &s, const std::string &pattern, int nmatch, const std::string &replace_string)
 {
     const int MAX_CAP_GROUPS = 10;
     int cap_group_count = std::min(nmatch+1, MAX_CAP_GROUPS);
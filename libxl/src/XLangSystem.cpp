@@ -45,18 +45,15 @@
 
 namespace xl { namespace system {
 
+// not cached: a function static would race between threads
 std::string get_execname()
 {
-    static std::string execname;
-    if(execname.size())
-        return execname;
     char buf[MAX_EXECNAME_SIZE];
     int n = readlink("/proc/self/exe", buf, sizeof(buf)-1);
     if(n == -1)
         return "";
     buf[n] = '\0';
-    execname = buf;
-    return execname;
+    return buf;
 }
 
 std::string shell_capture(std::string cmd)
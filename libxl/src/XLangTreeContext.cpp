@@ -20,22 +20,21 @@
 
 namespace xl {
 
-std::string* TreeContext::alloc_string(std::string s)
+std::string* TreeContext::alloc_string(const std::string &s)
 {
     return new (PNEW_EX(m_alloc, std::, string, basic_string))
             std::string(s);
 }
 
-const std::string* TreeContext::alloc_unique_string(std::string name)
+const std::string* TreeContext::alloc_unique_string(const std::string &name)
 {
     auto p = m_string_set.find(&name);
-    if(p == m_string_set.end())
-    {
-        m_string_set.insert(new (PNEW_EX(m_alloc, std::, string, basic_string))
-                std::string(name));
-        p = m_string_set.find(&name);
-    }
-    return *p;
+    if(p != m_string_set.end())
+        return *p;
+    const std::string* s = new (PNEW_EX(m_alloc, std::, string, basic_string))
+            std::string(name);
+    m_string_set.insert(s);
+    return s;
 }
 
 }
@@ -63,22 +63,22 @@ void Visitor::dispatch_visit(const node::NodeIdentIFace* unknown)
     #endif
     switch(unknown->type()) {
         case node::NodeIdentIFace::INT:
-            visit(dynamic_cast<const node::TermNodeIFace<node::NodeIdentIFace::INT>*>(unknown));
+            visit(static_cast<const node::TermNodeIFace<node::NodeIdentIFace::INT>*>(unknown->iface()));
             break;
         case node::NodeIdentIFace::FLOAT:
-            visit(dynamic_cast<const node::TermNodeIFace<node::NodeIdentIFace::FLOAT>*>(unknown));
+            visit(static_cast<const node::TermNodeIFace<node::NodeIdentIFace::FLOAT>*>(unknown->iface()));
             break;
         case node::NodeIdentIFace::STRING:
-            visit(dynamic_cast<const node::TermNodeIFace<node::NodeIdentIFace::STRING>*>(unknown));
+            visit(static_cast<const node::TermNodeIFace<node::NodeIdentIFace::STRING>*>(unknown->iface()));
             break;
         case node::NodeIdentIFace::CHAR:
-            visit(dynamic_cast<const node::TermNodeIFace<node::NodeIdentIFace::CHAR>*>(unknown));
+            visit(static_cast<const node::TermNodeIFace<node::NodeIdentIFace::CHAR>*>(unknown->iface()));
             break;
         case node::NodeIdentIFace::IDENT:
-            visit(dynamic_cast<const node::TermNodeIFace<node::NodeIdentIFace::IDENT>*>(unknown));
+            visit(static_cast<const node::TermNodeIFace<node::NodeIdentIFace::IDENT>*>(unknown->iface()));
             break;
         case node::NodeIdentIFace::SYMBOL:
-            visit(dynamic_cast<const node::SymbolNodeIFace*>(unknown));
+            visit(static_cast<const node::SymbolNodeIFace*>(unknown->iface()));
             break;
         default:
             m_output_ss << "unknown node type" << std::endl;
@@ -100,7 +100,7 @@ void VisitorDFS::visit(const node::SymbolNodeIFace* _node)
     do {
         if(m_filter_cb) {
             if(child->type() == node::NodeIdentIFace::SYMBOL && !m_filter_cb(child)) {
-                VisitorDFS::visit(dynamic_cast<const node::SymbolNodeIFace*>(child));
+                VisitorDFS::visit(node::symbol_cast(child));
                 continue;
             }
         }
@@ -160,7 +160,7 @@ bool VisitorBFS::iter_next_state()
     do {
         _node = visit_state.front();
         if(_node && _node->type() == node::NodeIdentIFace::SYMBOL) {
-            auto symbol = dynamic_cast<const node::SymbolNodeIFace*>(_node);
+            auto symbol = node::symbol_cast(_node);
             for(int i = 0; i<static_cast<int>(symbol->size()); i++) {
                 visit_state.push((*symbol)[i]);
             }
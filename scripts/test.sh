@@ -53,7 +53,7 @@ if [ ! -f $GOLD_FILE ]; then
 fi
 
 EMIT_SH=`dirname $0`/"emit.sh"
-$EMIT_SH $EXEC $EXEC_FLAGS $INPUT_MODE $INPUT_FILE $TEMP_FILE_0
+$EMIT_SH $EXEC "$EXEC_FLAGS" $INPUT_MODE $INPUT_FILE $TEMP_FILE_0
 
 diff $TEMP_FILE_0 $GOLD_FILE | tee $TEMP_FILE_1
 if [ ${PIPESTATUS[0]} -ne 0 ]; then # $? captures the last pipe